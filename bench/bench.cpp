@@ -0,0 +1,223 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+// Microbenchmarks for the simulation hot paths. Only needs the files in
+// src/core and glm, e.g.
+//
+//   g++ -std=c++17 -O2 -I../src/core -I<path to glm> bench.cpp ../src/core/*.cpp -o spacegame_bench
+//
+// usage: spacegame_bench [--json] [--max n] [--filter name]
+//
+// Every case is run at several entity counts and reports ns per call
+// (ns/op) and entities processed per second (items/s), as CSV by default
+// or JSON with --json.
+//
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "Emitter.h"
+#include "Explosion.h"
+#include "Sprite.h"
+
+// each case is repeated until it has run for at least this long
+#define MIN_SECONDS 0.2
+
+// the collision case spreads its sprites over a world that grows past
+// the window so no more than this many share a window's worth of space
+#define MAX_SPRITES_PER_SCREEN 1000
+
+struct Result {
+	std::string name;
+	long long n;
+	long long iterations;
+	double nsPerOp;
+	double itemsPerSec;
+};
+
+static std::vector<Result> results;
+static std::mt19937 rng(1);
+
+static float randomFloat(float lo, float hi) {
+	return lo + (hi - lo) * (rng() / 4294967296.0);
+}
+
+//  Time op() until MIN_SECONDS have passed and record the average.
+//  items is how many entities one call of op() processes.
+//
+template <typename F>
+static void run(const std::string &name, long long n, long long items, F op) {
+	typedef std::chrono::steady_clock Clock;
+	long long iterations = 0;
+	double seconds = 0;
+	Clock::time_point start = Clock::now();
+	while (seconds < MIN_SECONDS) {
+		op();
+		iterations++;
+		seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	}
+	double nsPerOp = seconds * 1e9 / iterations;
+	results.push_back({ name, n, iterations, nsPerOp, items * 1e9 / nsPerOp });
+	fprintf(stderr, "%-24s n=%-8lld %12.1f ns/op\n", name.c_str(), n, nsPerOp);
+}
+
+// fill a system with n immortal sprites spread over a w x h world,
+// the window by default
+static void fill(SpriteSystem &sys, int n, float w = 1366, float h = 1024) {
+	Sprite s;
+	sys.reserve(n);
+	for (int i = 0; i < n; i++) {
+		s.trans = glm::vec3(randomFloat(0, w), randomFloat(0, h), 1);
+		s.velocity = glm::vec3(randomFloat(-400, 400), randomFloat(-400, 400), 0);
+		s.lifespan = -1;
+		sys.add(s);
+	}
+}
+
+static void benchSpriteUpdate(int n) {
+	SpriteSystem sys;
+	fill(sys, n);
+	SimClock clock;
+	run("SpriteSystem::update", n, n, [&]() {
+		clock.step();
+		sys.update(clock);
+	});
+}
+
+//  removeNear against points that miss, so the system keeps its size
+//  and every call walks all n sprites
+//
+static void benchRemoveNear(int n) {
+	SpriteSystem sys;
+	fill(sys, n);
+	run("SpriteSystem::removeNear", n, n, [&]() {
+		sys.removeNear(glm::vec3(-1000, -1000, 1), 50);
+	});
+}
+
+//  Collision query of n projectiles against n invaders, the way
+//  Game::collide does it for one set of invaders (hits aren't removed
+//  so every call sees the same sprites). Past MAX_SPRITES_PER_SCREEN
+//  the world grows with n, so the sprites near each shot stay about
+//  the same and the case measures how the grid scales rather than how
+//  many pairs fall within the radius.
+//
+static void benchFindHits(int n) {
+	float scale = std::sqrt(std::max(n, MAX_SPRITES_PER_SCREEN) / (float)MAX_SPRITES_PER_SCREEN);
+	float w = 1366 * scale;
+	float h = 1024 * scale;
+	SpriteSystem shots, invaders;
+	fill(shots, n, w, h);
+	fill(invaders, n, w, h);
+	std::vector<CollisionHit> hits;
+	run("SpriteSystem::findHits", n, n, [&]() {
+		hits.clear();
+		invaders.findHits(shots.x.data(), shots.y.data(), shots.vx.data(), shots.vy.data(), shots.size(),
+			50, 1.0f / 60, w, h, hits);
+	});
+}
+
+//  Emitter::update on an emitter that spawns n sprites every tick.
+//  They live for one tick, so from the second call on the system
+//  holds a steady two bursts and each call spawns, integrates and
+//  retires one of them; items are the sprites spawned.
+//
+static void benchEmitterSpawn(int n) {
+	SimClock clock;
+	SpriteSystem sys;
+	Emitter emitter(&sys);
+	emitter.setPosition(glm::vec3(683, 512, 1));
+	emitter.setVelocity(glm::vec3(0, FIRING_SPEED, 1));
+	emitter.setRate(clock.getTicksPerSecond() * n);
+	emitter.setLifespan(clock.toMillis(1));
+	emitter.start();
+	run("Emitter::update", n, n, [&]() {
+		clock.step();
+		emitter.update(clock);
+	});
+}
+
+//  Start an explosion and retire it again, so the pool never fills
+//
+static void benchExplosionCreate(int dust) {
+	SimClock clock;
+	ExplosionPool booms;
+	run("ExplosionPool::add", dust, dust, [&]() {
+		if (booms.add(clock, glm::vec3(683, 512, 1), 1, 1.5, 15, dust) == -1) abort();
+		booms.remove(0);
+	});
+}
+
+//  Update one explosion's debris. The explosion is started over every
+//  lifespan like in the game; left alone, the damped velocities decay
+//  into denormals and the benchmark would time those instead.
+//
+static void benchExplosionUpdate(int dust) {
+	SimClock clock;
+	ExplosionPool booms;
+	booms.add(clock, glm::vec3(683, 512, 1), 1, 1.5, 15, dust);
+	int64_t lifespan = clock.fromMillis(1500);
+	int64_t ticks = 0;
+	run("ExplosionPool::update", dust, dust, [&]() {
+		if (++ticks % lifespan == 0) {
+			booms.remove(0);
+			booms.add(clock, glm::vec3(683, 512, 1), 1, 1.5, 15, dust);
+		}
+		booms.update(clock.getDt());
+	});
+}
+
+static void writeCsv() {
+	printf("name,n,iterations,ns_per_op,items_per_sec\n");
+	for (const Result &r : results) {
+		printf("%s,%lld,%lld,%.2f,%.0f\n", r.name.c_str(), r.n, r.iterations, r.nsPerOp, r.itemsPerSec);
+	}
+}
+
+static void writeJson() {
+	printf("[\n");
+	for (size_t i = 0; i < results.size(); i++) {
+		const Result &r = results[i];
+		printf("  {\"name\": \"%s\", \"n\": %lld, \"iterations\": %lld, \"ns_per_op\": %.2f, \"items_per_sec\": %.0f}%s\n",
+			r.name.c_str(), r.n, r.iterations, r.nsPerOp, r.itemsPerSec, i + 1 < results.size() ? "," : "");
+	}
+	printf("]\n");
+}
+
+int main(int argc, char *argv[]) {
+	bool json = false;
+	long long maxCount = 1000000;
+	std::string filter;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--json") == 0) json = true;
+		else if (strcmp(argv[i], "--max") == 0 && i + 1 < argc) maxCount = atoll(argv[++i]);
+		else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) filter = argv[++i];
+	}
+	auto wanted = [&](const char *name) {
+		return filter.empty() || std::string(name).find(filter) != std::string::npos;
+	};
+
+	for (long long n = 10; n <= maxCount; n *= 10) {
+		if (wanted("SpriteSystem::update")) benchSpriteUpdate(n);
+		if (wanted("SpriteSystem::removeNear")) benchRemoveNear(n);
+		if (wanted("SpriteSystem::findHits")) benchFindHits(n);
+		if (wanted("Emitter::update")) benchEmitterSpawn(n);
+	}
+	int dustCounts[] = { 10, 25, 50, 100 };
+	for (int dust : dustCounts) {
+		if (wanted("ExplosionPool::add")) benchExplosionCreate(dust);
+		if (wanted("ExplosionPool::update")) benchExplosionUpdate(dust);
+	}
+
+	if (json) writeJson();
+	else writeCsv();
+	return 0;
+}
@@ -0,0 +1,69 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+// Headless driver: runs the game simulation with no window, GL or
+// audio, stepping a fixed number of ticks as fast as the CPU allows.
+// Only needs the files in src/core and glm, e.g.
+//
+//   g++ -std=c++17 -O2 -I../src/core -I<path to glm> main.cpp ../src/core/*.cpp -o spacegame_headless
+//
+// usage: spacegame_headless [ticks] [seed] [workers]
+//
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "Game.h"
+#include "Profiler.h"
+
+// sizes of the images in data/images, so collisions match the real game;
+// the default invader waves already have the sizes of their images
+#define SHIP_SIZE 100
+#define PROJECTILE_SIZE 40
+
+int main(int argc, char *argv[]) {
+	long long ticks = argc > 1 ? atoll(argv[1]) : 60 * 60;
+	uint32_t seed = argc > 2 ? (uint32_t)strtoul(argv[2], nullptr, 10) : 1;
+	int workers = argc > 3 ? atoi(argv[3]) : -1;
+
+	Game game(workers);
+	game.setup(1366, 1024, seed);
+	game.projectiles->setImage(NO_IMAGE, SHIP_SIZE, SHIP_SIZE);
+	game.projectiles->setChildSize(PROJECTILE_SIZE, PROJECTILE_SIZE);
+
+	// start the game and hold the fire button, turning the ship slowly
+	// so the shots sweep the whole screen
+	game.pressFire();
+
+	int peakSprites = 0;
+	int peakBooms = 0;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (long long i = 0; i < ticks; i++) {
+		game.spin(0.05f);
+		game.step();
+
+		int sprites = game.projectiles->sys->size() + game.invaders.getSpriteCount();
+		if (sprites > peakSprites) peakSprites = sprites;
+		if (game.booms.size() > peakBooms) peakBooms = game.booms.size();
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	printf("ticks %lld seed %u workers %d\n", ticks, seed, game.jobs.getWorkerCount());
+	printf("simulated %.1f s in %.3f s (%.0f ticks/s)\n",
+		game.clock.toSeconds(game.clock.now()), seconds, ticks / seconds);
+	printf("score %d\n", game.score);
+	printf("peak sprites %d, peak explosions %d\n", peakSprites, peakBooms);
+
+	// stage times over the last ticks the profiler kept
+	Profiler &profiler = Profiler::get();
+	printf("stage (ms, last %d ticks)   p50      p99\n", profiler.getTickCount());
+	for (int s = StageShip; s <= StageExplosions; s++) {
+		ProfileStage stage = (ProfileStage)s;
+		printf("  %-20s %8.4f %8.4f\n", Profiler::getStageName(stage),
+			profiler.getPercentile(stage, 50), profiler.getPercentile(stage, 99));
+	}
+	return 0;
+}
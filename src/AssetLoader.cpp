@@ -0,0 +1,110 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "AssetLoader.h"
+#include <chrono>
+
+AssetLoader::AssetLoader() {
+	stopping = false;
+	waiting = 0;
+}
+
+AssetLoader::~AssetLoader() {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread &t : threads) t.join();
+}
+
+void AssetLoader::setup(int threadCount) {
+	for (int i = 0; i < threadCount; i++) {
+		threads.emplace_back(&AssetLoader::threadLoop, this);
+	}
+}
+
+//  Add an image to the registry and queue it for decoding. A path that
+//  was already added just returns its handle.
+//
+ImageHandle AssetLoader::loadImage(ImageRegistry &images, const string &path) {
+	int known = images.size();
+	ImageHandle img = images.add(path);
+	if (images.size() == known) return img;
+
+	Job job;
+	job.img = img;
+	job.path = path;
+	job.ok = false;
+	job.decodeMs = 0;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		todo.push_back(job);
+	}
+	waiting++;
+	wake.notify_one();
+	return img;
+}
+
+//  Upload every image decoded since the last call. Returns how many
+//  were finished, failed ones included.
+//
+int AssetLoader::update(ImageRegistry &images) {
+	deque<Job> finished;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		finished.swap(done);
+	}
+
+	for (Job &job : finished) {
+		float uploadMs = 0;
+		if (job.ok) {
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			images.setPixels(job.img, job.pixels);
+			uploadMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+		else {
+			ofLogError("AssetLoader") << "can't load image: " << job.path;
+		}
+		timings.push_back({ job.path, job.decodeMs, uploadMs });
+		waiting--;
+	}
+	return finished.size();
+}
+
+//  Record an asset that was loaded some other way, e.g. a font
+//
+void AssetLoader::addTime(const string &name, float ms) {
+	timings.push_back({ name, ms, 0 });
+}
+
+void AssetLoader::logTimes() const {
+	for (const Timing &t : timings) {
+		ofLogNotice("AssetLoader") << t.name << ": " << ofToString(t.decodeMs, 2) << " ms load, "
+			<< ofToString(t.uploadMs, 2) << " ms upload";
+	}
+}
+
+void AssetLoader::threadLoop() {
+	while (true) {
+		Job job;
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			wake.wait(guard, [this]() { return stopping || !todo.empty(); });
+			if (stopping) return;
+			job = todo.front();
+			todo.pop_front();
+		}
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		job.ok = ofLoadImage(job.pixels, job.path);
+		job.decodeMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		std::lock_guard<std::mutex> guard(lock);
+		done.push_back(job);
+	}
+}
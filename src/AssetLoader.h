@@ -0,0 +1,57 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include "ofMain.h"
+#include "ImageRegistry.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+//  Decodes images on a few loader threads while the game keeps running.
+//  Textures can only be made on the main thread, so update() uploads
+//  everything that finished decoding since the last frame in one go.
+//  The time every asset took is kept and can be logged.
+//
+class AssetLoader {
+public:
+	AssetLoader();
+	~AssetLoader();
+	void setup(int threadCount = 2);
+	ImageHandle loadImage(ImageRegistry &images, const string &path);
+	int update(ImageRegistry &images);
+	bool isDone() const { return waiting == 0; }
+	void addTime(const string &name, float ms);
+	void logTimes() const;
+
+private:
+	struct Job {
+		ImageHandle img;
+		string path;
+		ofPixels pixels;
+		bool ok;
+		float decodeMs;
+	};
+	struct Timing {
+		string name;
+		float decodeMs;
+		float uploadMs;
+	};
+	void threadLoop();
+
+	vector<std::thread> threads;
+	std::mutex lock;
+	std::condition_variable wake;
+	deque<Job> todo;
+	deque<Job> done;
+	bool stopping;
+
+	// only touched on the main thread
+	int waiting; // images asked for and not uploaded yet
+	vector<Timing> timings;
+};
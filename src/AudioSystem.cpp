@@ -0,0 +1,101 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "AudioSystem.h"
+#include <cstring>
+
+// little endian integer of n bytes at p
+static uint32_t readLE(const unsigned char *p, int n) {
+	uint32_t value = 0;
+	for (int i = n - 1; i >= 0; i--) value = (value << 8) | p[i];
+	return value;
+}
+
+//  Length (ms) of a .wav file worked out from its header: the size of
+//  its data chunk over the bytes per second of its format chunk. 0 if
+//  the file isn't a wav file or either chunk is missing.
+//
+static float getWavMs(const string &path) {
+	ofBuffer buffer = ofBufferFromFile(path, true);
+	const unsigned char *data = (const unsigned char *)buffer.getData();
+	size_t size = buffer.size();
+	if (size < 12 || memcmp(data, "RIFF", 4) != 0 || memcmp(data + 8, "WAVE", 4) != 0) return 0;
+
+	uint32_t bytesPerSecond = 0;
+	uint32_t dataBytes = 0;
+	size_t chunk = 12;
+	while (chunk + 8 <= size) {
+		uint32_t chunkSize = readLE(data + chunk + 4, 4);
+		if (memcmp(data + chunk, "fmt ", 4) == 0 && chunk + 20 <= size) {
+			bytesPerSecond = readLE(data + chunk + 16, 4);
+		}
+		else if (memcmp(data + chunk, "data", 4) == 0) {
+			// a file cut short plays only what it holds
+			dataBytes = std::min((size_t)chunkSize, size - chunk - 8);
+		}
+		// chunks are padded to an even size
+		chunk += 8 + (size_t)chunkSize + (chunkSize & 1);
+	}
+	if (bytesPerSecond == 0) return 0;
+	return dataBytes * 1000.0f / bytesPerSecond;
+}
+
+AudioSystem::AudioSystem() {
+	maxGain = 2;
+	maxVoices = 16;
+}
+
+void AudioSystem::setup(int voiceCount) {
+	maxVoices = voiceCount;
+}
+
+//  Load a sound once. Returns NO_SOUND if the file can't be loaded,
+//  triggering NO_SOUND does nothing.
+//
+SoundId AudioSystem::load(const string &path, float volume) {
+	sounds.emplace_back();
+	Sound &sound = sounds.back();
+	if (!sound.player.load(path)) {
+		sounds.pop_back();
+		return NO_SOUND;
+	}
+	sound.player.setMultiPlay(true);
+	sound.volume = volume;
+	sound.voiceMs = getWavMs(path);
+	if (sound.voiceMs <= 0) sound.voiceMs = DEFAULT_VOICE_MS;
+	triggered.push_back(0);
+	return sounds.size() - 1;
+}
+
+void AudioSystem::trigger(SoundId id, int count) {
+	if (id < 0 || id >= triggered.size()) return;
+	triggered[id] += count;
+}
+
+//  Play this frame's triggers, one voice per sound
+//
+void AudioSystem::flush() {
+	for (int i = 0; i < triggered.size(); i++) {
+		if (triggered[i] > 0) play(i, triggered[i]);
+		triggered[i] = 0;
+	}
+}
+
+void AudioSystem::play(SoundId id, int count) {
+	// free the voices that have finished
+	uint64_t now = ofGetElapsedTimeMillis();
+	voices.erase(remove_if(voices.begin(), voices.end(),
+		[now](uint64_t end) { return end <= now; }), voices.end());
+	if (voices.size() >= maxVoices) return;
+
+	// the volume is set on the channel play() just started, setting it
+	// first would change the voice before it instead
+	Sound &sound = sounds[id];
+	sound.player.play();
+	sound.player.setVolume(sound.volume * min(maxGain, sqrtf(count)));
+	voices.push_back(now + sound.voiceMs);
+}
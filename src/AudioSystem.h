@@ -0,0 +1,56 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include "ofMain.h"
+
+typedef int SoundId;
+const SoundId NO_SOUND = -1;
+
+// how long (ms) a voice of a sound whose length can't be read holds
+// its place in the pool
+#define DEFAULT_VOICE_MS 1000
+
+//  Plays the game's sounds. Every sound is loaded once and played as
+//  overlapping voices of the same sample. The triggers of a frame are
+//  merged, so a sound asked for n times plays once, louder the more it
+//  was asked for. At most maxVoices sounds play at a time; triggers
+//  past that are dropped. A voice holds its place for the whole length
+//  of its sample, read from the header of .wav files.
+//
+//  Everything here runs on the main thread, the one that calls
+//  ofSoundUpdate() every frame: FMOD's system object isn't safe to
+//  play on while another thread updates it. The simulation thread only
+//  counts sound events, so none of this slows it down.
+//
+class AudioSystem {
+public:
+	AudioSystem();
+	void setup(int voiceCount = 16);
+	SoundId load(const string &path, float volume = 1); // NO_SOUND if it can't be loaded
+	void trigger(SoundId id, int count = 1); // ids not loaded are ignored
+	void flush();
+
+	// volume boost for a sound triggered n times is sqrt(n), up to this
+	float maxGain;
+
+private:
+	struct Sound {
+		ofSoundPlayer player;
+		float volume;
+		float voiceMs; // length of the sample, how long one voice counts against the pool
+	};
+	void play(SoundId id, int count);
+
+	deque<Sound> sounds;
+	vector<int> triggered; // triggers since the last flush, per sound
+
+	// end times (ms) of the voices playing
+	vector<uint64_t> voices;
+	int maxVoices;
+};
@@ -0,0 +1,64 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "DebrisRenderer.h"
+
+DebrisRenderer::DebrisRenderer() {
+	mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+	mesh.setUsage(GL_STREAM_DRAW);
+	color = ofFloatColor(1, 0, 0, 1);
+	debrisSize = 5;
+	quads = 0;
+}
+
+//  Write a quad for every debris particle of a snapshot, moved back
+//  along its velocity by lag seconds
+//
+void DebrisRenderer::update(const GameSnapshot &snapshot, float lag) {
+	quads = snapshot.debrisX.size();
+
+	vector<glm::vec3> &verts = mesh.getVertices();
+	vector<ofFloatColor> &colors = mesh.getColors();
+	vector<unsigned int> &indices = mesh.getIndices();
+	verts.resize(quads * 4);
+	colors.resize(quads * 4);
+	indices.resize(quads * 6);
+
+	// debris is drawn up and to the left of the particle like before
+	float s = debrisSize;
+	int q = 0;
+	for (const Explosion &e : snapshot.booms) {
+		ofFloatColor c = color;
+		if (e.lifespan > 0) c.a *= ofClamp(1 - (float)e.age(snapshot.tick) / e.lifespan, 0, 1);
+
+		for (int p = e.firstParticle; p < e.firstParticle + e.debrisCount; p++, q++) {
+			float x = snapshot.debrisX[p] - snapshot.debrisVx[p] * lag - s;
+			float y = snapshot.debrisY[p] - snapshot.debrisVy[p] * lag - s;
+			unsigned int base = q * 4;
+			verts[base] = glm::vec3(x, y, 0);
+			verts[base + 1] = glm::vec3(x + s, y, 0);
+			verts[base + 2] = glm::vec3(x + s, y + s, 0);
+			verts[base + 3] = glm::vec3(x, y + s, 0);
+			colors[base] = c;
+			colors[base + 1] = c;
+			colors[base + 2] = c;
+			colors[base + 3] = c;
+			indices[q * 6] = base;
+			indices[q * 6 + 1] = base + 1;
+			indices[q * 6 + 2] = base + 2;
+			indices[q * 6 + 3] = base;
+			indices[q * 6 + 4] = base + 2;
+			indices[q * 6 + 5] = base + 3;
+		}
+	}
+}
+
+void DebrisRenderer::draw() {
+	if (quads == 0) return;
+	ofSetColor(255, 255, 255, 255);
+	mesh.draw();
+}
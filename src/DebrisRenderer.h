@@ -0,0 +1,31 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include "ofMain.h"
+#include "core/GameSnapshot.h"
+
+//  Draws the debris of every live explosion in one call. Each particle
+//  is a small untextured quad and the explosion's colour, faded by how
+//  far through its life it is, is written into the vertex colours.
+//  The vertex arrays are rewritten in place every frame.
+//
+class DebrisRenderer {
+public:
+	DebrisRenderer();
+	void update(const GameSnapshot &snapshot, float lag);
+	void draw();
+	int getQuadCount() const { return quads; }
+
+	ofFloatColor color;
+	float debrisSize;
+
+private:
+	ofVboMesh mesh;
+	int quads;
+};
@@ -0,0 +1,58 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "EmitterLoader.h"
+
+// read a [min, max] pair if the key is there
+static void readRange(const ofJson &json, const string &key, float &lo, float &hi) {
+	if (!json.contains(key)) return;
+	lo = json[key][0].get<float>();
+	hi = json[key][1].get<float>();
+}
+
+static SpawnEdge readEdge(const string &name) {
+	if (name == "left") return EdgeLeft;
+	if (name == "right") return EdgeRight;
+	if (name == "bottom") return EdgeBottom;
+	if (name == "corner") return EdgeCorner;
+	return EdgeTop;
+}
+
+bool loadEmitterDefs(const string &path, vector<EmitterDef> &waves) {
+	ofJson json = ofLoadJson(path);
+	if (!json.contains("waves") || !json["waves"].is_array()) {
+		ofLogError("loadEmitterDefs") << "no waves in " << path;
+		return false;
+	}
+
+	vector<EmitterDef> loaded;
+	try {
+		for (const ofJson &w : json["waves"]) {
+			EmitterDef def;
+			def.name = w.value("name", "wave " + ofToString(loaded.size() + 1));
+			def.edge = readEdge(w.value("edge", string("top")));
+			readRange(w, "edgeRange", def.edgeMin, def.edgeMax);
+			readRange(w, "speed", def.speedMin, def.speedMax);
+			def.speedPerPoint = w.value("speedPerPoint", def.speedPerPoint);
+			readRange(w, "angle", def.angleMin, def.angleMax);
+			readRange(w, "rate", def.rateMin, def.rateMax);
+			def.ratePerPoint = w.value("ratePerPoint", def.ratePerPoint);
+			def.lifespan = w.value("lifespan", def.lifespan);
+			def.points = w.value("points", def.points);
+			def.image = w.value("image", string());
+			readRange(w, "size", def.width, def.height);
+			loaded.push_back(def);
+		}
+	}
+	catch (const std::exception &e) {
+		ofLogError("loadEmitterDefs") << "bad wave in " << path << ": " << e.what();
+		return false;
+	}
+
+	waves = loaded;
+	return true;
+}
@@ -0,0 +1,24 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include "ofMain.h"
+#include "core/EmitterGroup.h"
+
+//  Reads the invader waves from a JSON file in the data folder, e.g.
+//
+//    { "waves": [ { "name": "top", "edge": "top", "edgeRange": [0.05, 0.95],
+//        "speed": [400, 601], "speedPerPoint": 0.75, "angle": [-45, 46],
+//        "rate": [0.25, 0.51], "ratePerPoint": 0.002, "lifespan": 4,
+//        "points": 1, "image": "images/P1_enemy.png", "size": [60, 60] } ] }
+//
+//  edge is one of top, left, right, bottom or corner. Any field left
+//  out keeps the EmitterDef default. Returns false and leaves waves
+//  untouched if the file can't be read.
+//
+bool loadEmitterDefs(const string &path, vector<EmitterDef> &waves);
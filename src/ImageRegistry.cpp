@@ -0,0 +1,49 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "ImageRegistry.h"
+
+//  Load an image from the data folder, or return the handle of the
+//  copy already loaded from that path. Returns NO_IMAGE on failure.
+//
+ImageHandle ImageRegistry::load(const string &path) {
+	map<string, ImageHandle>::iterator found = handles.find(path);
+	if (found != handles.end()) return found->second;
+
+	images.emplace_back();
+	if (!images.back().load(path)) {
+		images.pop_back();
+		return NO_IMAGE;
+	}
+
+	ImageHandle handle = images.size() - 1;
+	loaded.push_back(true);
+	handles[path] = handle;
+	return handle;
+}
+
+//  Reserve a handle for an image that is loaded elsewhere, or return
+//  the handle already given to that path
+//
+ImageHandle ImageRegistry::add(const string &path) {
+	map<string, ImageHandle>::iterator found = handles.find(path);
+	if (found != handles.end()) return found->second;
+
+	images.emplace_back();
+	loaded.push_back(false);
+	ImageHandle handle = images.size() - 1;
+	handles[path] = handle;
+	return handle;
+}
+
+//  Give an added image its decoded pixels and upload its texture,
+//  must be called on the main (GL) thread
+//
+void ImageRegistry::setPixels(ImageHandle img, const ofPixels &pixels) {
+	images[img].setFromPixels(pixels);
+	loaded[img] = true;
+}
@@ -0,0 +1,34 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include "ofMain.h"
+#include "core/ImageHandle.h"
+
+//  Loads every image asset exactly once and hands out handles to it.
+//  Loading the same path twice returns the handle of the first load.
+//  An image can also be added first and given its pixels later, once
+//  they have been decoded on another thread; it isn't valid until then.
+//
+class ImageRegistry {
+public:
+	ImageHandle load(const string &path);
+	ImageHandle add(const string &path);
+	void setPixels(ImageHandle img, const ofPixels &pixels);
+	bool isValid(ImageHandle img) const { return img < images.size() && loaded[img]; }
+	const ofImage &get(ImageHandle img) const { return images[img]; }
+	float getWidth(ImageHandle img) const { return images[img].getWidth(); }
+	float getHeight(ImageHandle img) const { return images[img].getHeight(); }
+	int size() const { return images.size(); }
+
+private:
+	// deque so references handed out by get() stay valid as images are added
+	deque<ofImage> images;
+	vector<bool> loaded;
+	map<string, ImageHandle> handles;
+};
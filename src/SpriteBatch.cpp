@@ -0,0 +1,202 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "SpriteBatch.h"
+#include "core/GameSnapshot.h"
+
+#define ATLAS_PADDING 1
+#define WHITE_SIZE 4
+
+SpriteBatch::SpriteBatch() {
+	mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+	mesh.setUsage(GL_STREAM_DRAW);
+	quads = 0;
+	viewWidth = 0;
+	viewHeight = 0;
+	culled = 0;
+}
+
+//  Pack the given images into one texture. Images are placed on shelves
+//  sorted by height, with a small white block in the first shelf for
+//  sprites that have no image.
+//
+void SpriteBatch::buildAtlas(const ImageRegistry &images, const vector<ImageHandle> &handles) {
+	vector<ImageHandle> sorted;
+	int maxWidth = WHITE_SIZE;
+	for (ImageHandle h : handles) {
+		if (!images.isValid(h)) continue;
+		sorted.push_back(h);
+		maxWidth = max(maxWidth, (int)images.getWidth(h) + ATLAS_PADDING);
+	}
+	sort(sorted.begin(), sorted.end(), [&images](ImageHandle a, ImageHandle b) {
+		return images.getHeight(a) > images.getHeight(b);
+	});
+
+	// atlas is at least 256 wide and grows to fit the widest image
+	int atlasWidth = 256;
+	while (atlasWidth < maxWidth) atlasWidth *= 2;
+
+	// first pass only works out where each image goes
+	vector<glm::ivec2> spots(sorted.size());
+	int x = WHITE_SIZE + ATLAS_PADDING, y = 0, shelfHeight = WHITE_SIZE;
+	for (int i = 0; i < sorted.size(); i++) {
+		int w = images.getWidth(sorted[i]);
+		int h = images.getHeight(sorted[i]);
+		if (x + w > atlasWidth) {
+			x = 0;
+			y += shelfHeight + ATLAS_PADDING;
+			shelfHeight = 0;
+		}
+		spots[i] = glm::ivec2(x, y);
+		x += w + ATLAS_PADDING;
+		shelfHeight = max(shelfHeight, h);
+	}
+	int atlasHeight = 1;
+	while (atlasHeight < y + shelfHeight) atlasHeight *= 2;
+
+	ofPixels pixels;
+	pixels.allocate(atlasWidth, atlasHeight, OF_IMAGE_COLOR_ALPHA);
+	pixels.setColor(ofColor(0, 0, 0, 0));
+	for (int wy = 0; wy < WHITE_SIZE; wy++) {
+		for (int wx = 0; wx < WHITE_SIZE; wx++) {
+			pixels.setColor(wx, wy, ofColor(255, 255, 255, 255));
+		}
+	}
+	for (int i = 0; i < sorted.size(); i++) {
+		// every image is converted to RGBA so they all paste the same way
+		ofPixels imgPixels = images.get(sorted[i]).getPixels();
+		imgPixels.setImageType(OF_IMAGE_COLOR_ALPHA);
+		imgPixels.pasteInto(pixels, spots[i].x, spots[i].y);
+	}
+	atlas.allocate(pixels);
+	atlas.loadData(pixels);
+
+	// sample from the middle of the white block so filtering stays white
+	glm::vec2 white = atlas.getCoordFromPoint(WHITE_SIZE / 2.0, WHITE_SIZE / 2.0);
+	whiteRect = glm::vec4(white.x, white.y, white.x, white.y);
+
+	uvRects.assign(images.size(), whiteRect);
+	inAtlas.assign(images.size(), false);
+	for (int i = 0; i < sorted.size(); i++) {
+		glm::vec2 uv0 = atlas.getCoordFromPoint(spots[i].x, spots[i].y);
+		glm::vec2 uv1 = atlas.getCoordFromPoint(spots[i].x + images.getWidth(sorted[i]),
+			spots[i].y + images.getHeight(sorted[i]));
+		uvRects[sorted[i]] = glm::vec4(uv0.x, uv0.y, uv1.x, uv1.y);
+		inAtlas[sorted[i]] = true;
+	}
+}
+
+//  Start a new frame
+//
+void SpriteBatch::begin() {
+	mesh.getVertices().clear();
+	mesh.getTexCoords().clear();
+	mesh.getColors().clear();
+	mesh.getIndices().clear();
+	quads = 0;
+	culled = 0;
+}
+
+void SpriteBatch::addCorners(ImageHandle img, const glm::vec3 *corners, const ofFloatColor &color) {
+	glm::vec4 uv = whiteRect;
+	if (img < inAtlas.size() && inAtlas[img]) uv = uvRects[img];
+
+	vector<glm::vec3> &verts = mesh.getVertices();
+	vector<glm::vec2> &texCoords = mesh.getTexCoords();
+	vector<ofFloatColor> &colors = mesh.getColors();
+	vector<unsigned int> &indices = mesh.getIndices();
+
+	unsigned int base = verts.size();
+	verts.push_back(corners[0]);
+	verts.push_back(corners[1]);
+	verts.push_back(corners[2]);
+	verts.push_back(corners[3]);
+	texCoords.push_back(glm::vec2(uv.x, uv.y));
+	texCoords.push_back(glm::vec2(uv.z, uv.y));
+	texCoords.push_back(glm::vec2(uv.z, uv.w));
+	texCoords.push_back(glm::vec2(uv.x, uv.w));
+	for (int i = 0; i < 4; i++) colors.push_back(color);
+	indices.push_back(base);
+	indices.push_back(base + 1);
+	indices.push_back(base + 2);
+	indices.push_back(base);
+	indices.push_back(base + 2);
+	indices.push_back(base + 3);
+	quads++;
+}
+
+//  Add an axis aligned quad with its top left corner at (x, y)
+//
+void SpriteBatch::addRect(ImageHandle img, float x, float y, float w, float h, const ofFloatColor &color) {
+	glm::vec3 corners[4] = {
+		glm::vec3(x, y, 0),
+		glm::vec3(x + w, y, 0),
+		glm::vec3(x + w, y + h, 0),
+		glm::vec3(x, y + h, 0)
+	};
+	addCorners(img, corners, color);
+}
+
+//  Add a quad of size w x h centered on the origin of transform t
+//
+void SpriteBatch::addQuad(ImageHandle img, const Transform2D &t, float w, float h, const ofFloatColor &color) {
+	glm::vec3 corners[4] = {
+		glm::vec3(t.apply(glm::vec2(-w / 2, -h / 2)), 0),
+		glm::vec3(t.apply(glm::vec2(w / 2, -h / 2)), 0),
+		glm::vec3(t.apply(glm::vec2(w / 2, h / 2)), 0),
+		glm::vec3(t.apply(glm::vec2(-w / 2, h / 2)), 0)
+	};
+	addCorners(img, corners, color);
+}
+
+//  Add all sprites of a snapshot that are on screen, moved back along
+//  their velocity by lag seconds. Sprites without an image are drawn
+//  as red rectangles like before.
+//
+void SpriteBatch::addSprites(const SpriteSnapshot &sprites, float lag) {
+	bool cull = viewWidth > 0 && viewHeight > 0;
+	for (int i = 0; i < sprites.size(); i++) {
+		float w = sprites.width[i];
+		float h = sprites.height[i];
+		float x = sprites.x[i] - sprites.vx[i] * lag;
+		float y = sprites.y[i] - sprites.vy[i] * lag;
+		if (cull && (x + w / 2 < 0 || x - w / 2 > viewWidth ||
+			y + h / 2 < 0 || y - h / 2 > viewHeight)) {
+			culled++;
+			continue;
+		}
+		if (sprites.image[i] != NO_IMAGE) {
+			addRect(sprites.image[i], x - w / 2, y - h / 2, w, h, ofFloatColor(1, 1, 1, 1));
+		}
+		else {
+			addRect(NO_IMAGE, x - w / 2, y - h / 2, w, h, ofFloatColor(1, 0, 0, 1));
+		}
+	}
+}
+
+//  Add the ship alpha of the way from its last pose, if it is drawable
+//
+void SpriteBatch::addShip(const ShipSnapshot &ship, float alpha) {
+	if (!ship.drawable) return;
+
+	if (ship.haveImage) {
+		addQuad(ship.image, ship.getTransform(alpha), ship.width, ship.height, ofFloatColor(1, 1, 1, 1));
+	}
+	else {
+		addQuad(NO_IMAGE, ship.getTransform(alpha), ship.width, ship.height, ofFloatColor(0, 0, 200 / 255.0, 1));
+	}
+}
+
+//  Draw everything added since begin() with the atlas bound
+//
+void SpriteBatch::draw() {
+	if (quads == 0) return;
+	ofSetColor(255, 255, 255, 255);
+	atlas.bind();
+	mesh.draw();
+	atlas.unbind();
+}
@@ -0,0 +1,52 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include "ofMain.h"
+#include "ImageRegistry.h"
+#include "core/Transform2D.h"
+
+struct SpriteSnapshot;
+struct ShipSnapshot;
+
+//  Draws every sprite and the ship in one call. The sprite images
+//  are packed into a single atlas texture and each frame the sprites
+//  are written into one vertex buffer of textured quads.
+//
+class SpriteBatch {
+public:
+	SpriteBatch();
+	void buildAtlas(const ImageRegistry &images, const vector<ImageHandle> &handles);
+	void setView(float w, float h) { viewWidth = w; viewHeight = h; }
+	void begin();
+	void addSprites(const SpriteSnapshot &, float lag);
+	void addShip(const ShipSnapshot &, float alpha);
+	void addQuad(ImageHandle img, const Transform2D &t, float w, float h, const ofFloatColor &color);
+	void addRect(ImageHandle img, float x, float y, float w, float h, const ofFloatColor &color);
+	void draw();
+	int getQuadCount() const { return quads; }
+	int getCulledCount() const { return culled; }
+
+private:
+	void addCorners(ImageHandle img, const glm::vec3 *corners, const ofFloatColor &color);
+
+	// texture coords of each image in the atlas as (u0, v0, u1, v1),
+	// indexed by image handle
+	vector<glm::vec4> uvRects;
+	vector<bool> inAtlas;
+	// small block of white texels used to draw untextured rectangles
+	glm::vec4 whiteRect;
+
+	ofTexture atlas;
+	ofVboMesh mesh;
+	int quads;
+	// sprites outside (0, 0) to (viewWidth, viewHeight) are not drawn,
+	// a size of 0 turns culling off
+	float viewWidth, viewHeight;
+	int culled;
+};
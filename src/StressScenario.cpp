@@ -0,0 +1,135 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "StressScenario.h"
+#include "core/Profiler.h"
+
+// frames and ticks the profiler keeps while recording, the oldest
+// are dropped past this
+#define STRESS_MAX_FRAMES 100000
+
+// time (ms) p percent of the values stay under
+static double percentile(vector<double> values, double p) {
+	if (values.empty()) return 0;
+	int k = min((int)(p / 100.0 * values.size()), (int)values.size() - 1);
+	nth_element(values.begin(), values.begin() + k, values.end());
+	return values[k];
+}
+
+//  Read the scenario options. Nothing but --stress turns it on, the
+//  other options only change the run.
+//
+bool StressScenario::parse(int argc, char *argv[]) {
+	for (int i = 1; i < argc; i++) {
+		string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--stress") enabled = true;
+		else if (arg == "--sprites" && hasValue) sprites = atoi(argv[++i]);
+		else if (arg == "--seconds" && hasValue) seconds = atof(argv[++i]);
+		else if (arg == "--seed" && hasValue) seed = (uint32_t)strtoul(argv[++i], nullptr, 10);
+		else if (arg == "--out" && hasValue) resultsPath = argv[++i];
+		else {
+			ofLogError("StressScenario") << "unknown argument " << arg << ", usage: "
+				<< "--stress [--sprites N] [--seconds S] [--seed N] [--out file]";
+			return false;
+		}
+	}
+	sprites = ofClamp(sprites, 0, STRESS_MAX_SPRITES);
+	return true;
+}
+
+//  Give every invader wave an even share of the sprites: a fixed rate
+//  that keeps sprites / waves alive over its lifespan unless they are
+//  shot. Sprites wrap at the edges so they live out their whole
+//  lifespan, and neither rate nor speed goes up with the score so the
+//  load stays the same for the whole run.
+//
+void StressScenario::setup(Game &game) {
+	int waves = game.invaders.size();
+	for (EmitterDef &def : game.invaders.defs) {
+		float rate = def.lifespan > 0 ? (float)sprites / waves / def.lifespan : 0;
+		def.rateMin = rate;
+		def.rateMax = rate;
+		def.ratePerPoint = 0;
+		def.speedPerPoint = 0;
+		warmup = max(warmup, (double)def.lifespan);
+	}
+	game.settings.spriteBounds = BoundsWrap;
+
+	elapsed = 0;
+	frameMs.clear();
+	systemNames = { "projectiles" };
+	for (const EmitterDef &def : game.invaders.defs) systemNames.push_back(def.name);
+	peakSprites.assign(systemNames.size(), 0);
+	peakBooms = 0;
+	ofLogNotice("StressScenario") << sprites << " sprites for " << seconds << " s, seed " << seed;
+}
+
+// hold the fire button down, turning the ship slowly so the shots
+// sweep the whole screen
+void StressScenario::drive(SimThread &sim) {
+	sim.post([](Game &game) {
+		if (!game.projectiles->started || !game.projectiles->playFireSound) game.pressFire();
+		game.spin(0.05f);
+	});
+}
+
+//  Count one frame. Before the warm up is over nothing is kept; once
+//  it is, the profiler starts over so its percentiles only cover the
+//  recorded frames and ticks.
+//
+bool StressScenario::record(const GameSnapshot &snapshot, double frameSeconds) {
+	if (warmup > 0) {
+		warmup -= frameSeconds;
+		if (warmup <= 0) Profiler::get().reset(STRESS_MAX_FRAMES);
+		return false;
+	}
+
+	frameMs.push_back(frameSeconds * 1000);
+	for (int i = 0; i < peakSprites.size() && i < snapshot.systems.size(); i++) {
+		peakSprites[i] = max(peakSprites[i], snapshot.systems[i].size());
+	}
+	peakBooms = max(peakBooms, (int)snapshot.booms.size());
+
+	elapsed += frameSeconds;
+	return elapsed >= seconds;
+}
+
+//  Write the frame time and every stage's p50/p99/max (ms) over the
+//  recorded frames, or the recorded ticks for the simulation stages,
+//  then the peak count of every sprite system and of the explosions
+//
+bool StressScenario::writeResults() const {
+	string path = ofToDataPath(resultsPath);
+	FILE *file = fopen(path.c_str(), "w");
+	if (!file) {
+		ofLogError("StressScenario") << "can't write " << path;
+		return false;
+	}
+
+	Profiler &profiler = Profiler::get();
+	fprintf(file, "sprites,%d\nseconds,%.1f\nseed,%u\nframes,%d\nfps,%.1f\nticks,%d\n\n",
+		sprites, elapsed, seed, (int)frameMs.size(), frameMs.size() / max(elapsed, 1e-9), profiler.getTickCount());
+	fprintf(file, "stage,p50 ms,p99 ms,max ms\n");
+	fprintf(file, "frame,%.4f,%.4f,%.4f\n", percentile(frameMs, 50), percentile(frameMs, 99),
+		frameMs.empty() ? 0 : *max_element(frameMs.begin(), frameMs.end()));
+	for (int s = 0; s < StageCount; s++) {
+		ProfileStage stage = (ProfileStage)s;
+		fprintf(file, "%s,%.4f,%.4f,%.4f\n", Profiler::getStageName(stage),
+			profiler.getPercentile(stage, 50), profiler.getPercentile(stage, 99), profiler.getMax(stage));
+	}
+
+	fprintf(file, "\nsystem,peak count\n");
+	for (int i = 0; i < peakSprites.size(); i++) {
+		fprintf(file, "%s,%d\n", systemNames[i].c_str(), peakSprites[i]);
+	}
+	fprintf(file, "booms,%d\n", peakBooms);
+	fclose(file);
+
+	ofLogNotice("StressScenario") << "results written to " << path;
+	return true;
+}
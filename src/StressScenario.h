@@ -0,0 +1,51 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include "ofMain.h"
+#include "core/SimThread.h"
+
+// most invader sprites the scenario will try to keep alive at once
+#define STRESS_MAX_SPRITES 100000
+
+//  Stress test run, picked from the command line:
+//
+//    spacegame --stress [--sprites N] [--seconds S] [--seed N] [--out file]
+//
+//  The invader waves spawn at fixed rates that would keep about N
+//  sprites alive between them (wrapping at the screen edges instead of
+//  leaving) and the fire button is held down, so the shots keep the
+//  real count somewhat lower. After a warm up of one invader
+//  lifespan the frames are recorded for S seconds, then the frame time
+//  and per stage p50/p99/max (over ticks for the simulation stages)
+//  and the peak sprite count of every sprite system and of the
+//  explosions are written to the results file (in the data folder)
+//  and the app exits.
+//
+class StressScenario {
+public:
+	bool parse(int argc, char *argv[]); // false if the arguments are bad
+	void setup(Game &game); // before the simulation thread starts
+	void drive(SimThread &sim);
+	bool record(const GameSnapshot &snapshot, double frameSeconds); // true once done
+	bool writeResults() const;
+
+	bool enabled = false;
+	int sprites = 10000;
+	float seconds = 30;
+	uint32_t seed = 1;
+	string resultsPath = "stress_results.csv";
+
+private:
+	double warmup = 0;  // seconds left before recording starts
+	double elapsed = 0; // seconds recorded
+	vector<double> frameMs;
+	vector<string> systemNames;
+	vector<int> peakSprites; // projectiles, then each invader wave
+	int peakBooms = 0;
+};
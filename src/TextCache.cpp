@@ -0,0 +1,93 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "TextCache.h"
+
+CachedText::CachedText() {
+	font = nullptr;
+	number = 0;
+	haveNumber = false;
+	mesh.setUsage(GL_STATIC_DRAW);
+}
+
+void CachedText::setup(const ofTrueTypeFont *f, const string &text) {
+	font = f;
+	prefix = text;
+	haveNumber = false;
+}
+
+// lay the text out with its baseline at the origin, draw() moves it
+void CachedText::setText(const string &text) {
+	if (!font || !font->isLoaded()) return;
+	mesh = font->getStringMesh(text, 0, 0);
+	mesh.setUsage(GL_STATIC_DRAW);
+}
+
+void CachedText::setNumber(int n) {
+	if (haveNumber && n == number) return;
+	number = n;
+	haveNumber = true;
+	setText(prefix + std::to_string(n));
+}
+
+void CachedText::draw(float x, float y) {
+	if (!font || !font->isLoaded() || mesh.getNumVertices() == 0) return;
+	ofPushMatrix();
+	ofTranslate(x, y);
+	font->getFontTexture().bind();
+	mesh.draw();
+	font->getFontTexture().unbind();
+	ofPopMatrix();
+}
+
+LabelBatch::LabelBatch() {
+	font = nullptr;
+	mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+	mesh.setUsage(GL_STREAM_DRAW);
+}
+
+void LabelBatch::setup(const ofTrueTypeFont *f) {
+	font = f;
+	labels.clear();
+}
+
+void LabelBatch::bake(int key, const string &text) {
+	if (!font || !font->isLoaded()) return;
+	labels[key] = font->getStringMesh(text, 0, 0);
+}
+
+// start a new frame
+void LabelBatch::begin() {
+	mesh.getVertices().clear();
+	mesh.getTexCoords().clear();
+	mesh.getIndices().clear();
+}
+
+//  Add a baked label with its baseline at (x, y). Keys that were never
+//  baked are skipped.
+//
+void LabelBatch::add(int key, float x, float y) {
+	map<int, ofMesh>::iterator found = labels.find(key);
+	if (found == labels.end()) return;
+	ofMesh &label = found->second;
+
+	vector<glm::vec3> &verts = mesh.getVertices();
+	vector<glm::vec2> &texCoords = mesh.getTexCoords();
+	vector<unsigned int> &indices = mesh.getIndices();
+	unsigned int base = verts.size();
+	glm::vec3 offset(x, y, 0);
+	for (const glm::vec3 &v : label.getVertices()) verts.push_back(v + offset);
+	texCoords.insert(texCoords.end(), label.getTexCoords().begin(), label.getTexCoords().end());
+	for (unsigned int i : label.getIndices()) indices.push_back(base + i);
+}
+
+void LabelBatch::draw() {
+	if (!font || mesh.getNumVertices() == 0) return;
+	font->getFontTexture().bind();
+	mesh.draw();
+	font->getFontTexture().unbind();
+}
@@ -0,0 +1,48 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include "ofMain.h"
+
+//  A line of text kept as a glyph mesh. The text is only laid out
+//  again when it changes, drawing just reuses the mesh.
+//
+class CachedText {
+public:
+	CachedText();
+	void setup(const ofTrueTypeFont *font, const string &prefix = "");
+	void setText(const string &text);
+	void setNumber(int n); // prefix followed by n, rebuilt only when n changes
+	void draw(float x, float y);
+
+private:
+	const ofTrueTypeFont *font;
+	string prefix;
+	int number;
+	bool haveNumber;
+	ofVboMesh mesh;
+};
+
+//  Short labels such as the "+1" and "+4" over explosions. Each label
+//  is laid out once when it is baked; every frame the labels in use are
+//  copied into one mesh at their positions and drawn in one call.
+//
+class LabelBatch {
+public:
+	LabelBatch();
+	void setup(const ofTrueTypeFont *font);
+	void bake(int key, const string &text);
+	void begin();
+	void add(int key, float x, float y);
+	void draw();
+
+private:
+	const ofTrueTypeFont *font;
+	map<int, ofMesh> labels;
+	ofVboMesh mesh;
+};
@@ -0,0 +1,18 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "BaseObject.h"
+
+BaseObject::BaseObject() {
+	trans = glm::vec3(0, 0, 1);
+	scale = glm::vec3(1, 1, 1);
+	rot = 0;
+}
+
+void BaseObject::setPosition(glm::vec3 pos) {
+	trans = pos;
+}
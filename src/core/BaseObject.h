@@ -0,0 +1,24 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include "glm/glm.hpp"
+
+typedef enum { MoveStop, MoveLeft, MoveRight, MoveUp, MoveDown } MoveDir;
+
+// This is a base object that all drawable object inherit from
+// It is possible this will be replaced by ofNode when we move to 3D
+//
+class BaseObject {
+public:
+	BaseObject();
+	glm::vec3 trans, scale;
+	float	rot;
+	bool	bSelected;
+	void setPosition(glm::vec3);
+};
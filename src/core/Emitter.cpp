@@ -0,0 +1,175 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "Emitter.h"
+#include <algorithm>
+
+//  Create a new Emitter - needs a SpriteSystem
+//
+Emitter::Emitter(SpriteSystem *spriteSys) {
+	sys = spriteSys;
+	lifespan = LIFE;    // milliseconds
+	started = false;
+
+	spawnDebt = 0;
+	rate = 1;    // sprites/sec
+	haveChildImage = false;
+	haveImage = false;
+	childImage = NO_IMAGE;
+	image = NO_IMAGE;
+	firingDir = 0;
+	// store the rotation used for firing direction
+	// applied to velocity
+	rotDir = Transform2D::rotation(firingDir);
+	velocity = glm::vec4(glm::vec3(0, FIRING_SPEED, 1), 1);
+	// set initial turret travel direction using initial rotation amount
+	emitterRot = Transform2D::rotation(rot);
+	drawable = true;
+	width = 50;
+	height = 50;
+	childWidth = 60;
+	childHeight = 80;
+	bSelected = false;
+	playFireSound = false;
+	fireSoundCount = 0;
+
+	// initialize integrator vectors and values
+	moveVelocity = glm::vec3(0, 0, 0);
+	moveAcceleration = glm::vec3(0, 0, 0);
+	moveForces = glm::vec3(0, 0, 0);
+	moveRotVel = 0.0;
+	moveRotAcc = 0.0;
+	moveRotForces = 0.0;
+	moveDamping = 0.99;
+}
+
+//  Update the Emitter. If it has been started, spawn new sprites with
+//  initial velocity, lifespan, birthtime.
+//
+void Emitter::update(const SimClock &clock) {
+	if (!started) return;
+
+	// every tick adds rate * dt sprites to the debt and all whole
+	// sprites owed are spawned now, so the real rate matches rate
+	// however high it is
+	float dt = clock.getDt();
+	spawnDebt += rate * dt;
+	int count = (int)spawnDebt;
+	if (count > 0) {
+		spawnDebt -= count;
+		int64_t time = clock.now();
+
+		Sprite sprite;
+		if (haveChildImage) sprite.setImage(childImage, childWidth, childHeight);
+		// velocity keeps its original rate but is rotated by firing direction
+		sprite.velocity = rotDir.rotate(velocity);
+		sprite.lifespan = clock.fromMillis(lifespan);
+		// every sprite of the burst fell due within this tick and expiry
+		// counts whole ticks, so they are all born now and only their
+		// positions below carry the part of the tick
+		sprite.birthtime = time;
+
+		// grow by doubling like push_back would, but once for the burst
+		int needed = sys->size() + count;
+		if (sys->capacity() < needed) sys->reserve(std::max(needed, 2 * sys->capacity()));
+		for (int i = 0; i < count; i++) {
+			// sprite i fell due this long before the end of the tick;
+			// start it far enough back that after this tick's
+			// integration it is where it would have flown since then
+			float age = (spawnDebt + count - 1 - i) / rate;
+			sprite.setPosition(trans + sprite.velocity * (age - dt));
+			sys->add(sprite);
+		}
+		// utilizes established emitter update rate
+		// to check if sound should be played when firing
+		if (playFireSound) fireSoundCount += count;
+	}
+	sys->update(clock);
+}
+
+// Start/Stop the emitter.
+//
+void Emitter::start() {
+	started = true;
+	spawnDebt = 0;
+}
+
+void Emitter::stop() {
+	started = false;
+}
+
+
+void Emitter::setLifespan(float life) {
+	lifespan = life;
+}
+
+void Emitter::setVelocity(glm::vec3 v) {
+	velocity = v;
+}
+
+void Emitter::setChildImage(ImageHandle img) {
+	childImage = img;
+	haveChildImage = true;
+}
+
+void Emitter::setImage(ImageHandle img, float w, float h) {
+	image = img;
+	haveImage = true;
+	width = w;
+	height = h;
+}
+
+void Emitter::setRate(float r) {
+	rate = r;
+}
+
+
+// update the degree of rotation for firing direction
+// and apply changes to its sine and cosine
+void Emitter::setFiringDir(float deg) {
+	firingDir = deg;
+}
+
+void Emitter::setFiringMat(float deg) {
+	rotDir.setRotation(deg);
+}
+
+// set the rotation that will be applied to the heading of travel
+// for turret when key pressed
+void Emitter::setEmitterMat(float deg) {
+	emitterRot.setRotation(deg);
+}
+
+// integrator for moving an emitter
+void Emitter::integrate(float dt) {
+	// linear thrust
+	trans = trans + (moveVelocity * dt);
+	glm::vec3 accel = moveAcceleration;
+	accel = accel + moveForces;
+	moveVelocity = moveVelocity + (accel * dt);
+	moveVelocity = moveVelocity * moveDamping;
+
+	// angular thrust
+	float lastRot = rot;
+	rot = rot + (moveRotVel * dt);
+	float rotAcceler = moveRotAcc;
+	rotAcceler = rotAcceler + moveRotForces;
+	moveRotVel = moveRotVel + (rotAcceler * dt);
+	moveRotVel = moveRotVel * moveDamping;
+
+	// only when the turret turned, adjust rotation accordingly to
+	// guide turret travel heading and adjust firing direction
+	if (rot != lastRot) {
+		setEmitterMat(rot);
+		setFiringDir(rot);
+		setFiringMat(rot);
+	}
+
+	// reset forces after each integraion
+	moveRotForces = 0.0;
+	moveForces = glm::vec3(0, 0, 0);
+}
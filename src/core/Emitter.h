@@ -0,0 +1,67 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include "Sprite.h"
+#include "RandomStream.h"
+#include "Transform2D.h"
+
+#define FIRING_SPEED -1000
+#define LIFE 4000
+
+//  General purpose Emitter class for emitting sprites
+//  This works similar to a Particle emitter
+//
+class Emitter : public BaseObject {
+public:
+	Emitter(SpriteSystem *);
+	void start();
+	void stop();
+	void setLifespan(float);
+	void setVelocity(glm::vec3);
+	void setChildImage(ImageHandle);
+	void setChildSize(float w, float h) { childWidth = w; childHeight = h; }
+	void setImage(ImageHandle, float w, float h);
+	void setRate(float);
+	void setFiringDir(float);
+	void setFiringMat(float);
+	void setEmitterMat(float);
+	void update(const SimClock &);
+	void integrate(float dt);
+
+	glm::vec3 moveVelocity;
+	glm::vec3 moveAcceleration;
+	glm::vec3 moveForces;
+	float moveRotVel;
+	float moveRotAcc;
+	float moveRotForces;
+	float moveDamping;
+
+	SpriteSystem *sys;
+	float rate;
+	float firingDir;
+	Transform2D rotDir;     // rotation only
+	glm::vec3 velocity;
+	float lifespan; // in ms
+	bool started;
+	double spawnDebt;    // sprites owed, the fraction carries over to the next tick
+	ImageHandle childImage;
+	ImageHandle image;
+	bool drawable;
+	bool haveChildImage;
+	bool haveImage;
+	float width, height;
+	float childWidth, childHeight;
+	Transform2D emitterRot; // rotation only
+	// spawns that should play the fire sound, counted until the front
+	// end plays them and clears the count
+	bool playFireSound;
+	int fireSoundCount;
+	// randomizes this emitter's spawns, seeded from the game's seed
+	RandomStream rng;
+};
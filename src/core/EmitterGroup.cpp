@@ -0,0 +1,147 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "EmitterGroup.h"
+
+EmitterGroup::~EmitterGroup() {
+	clear();
+}
+
+//  Create an emitter for every wave. The emitters draw from the random
+//  streams firstStream, firstStream + 1, ... of seed.
+//
+void EmitterGroup::setup(const std::vector<EmitterDef> &waves, uint32_t seed, int firstStream) {
+	clear();
+	defs = waves;
+	for (int i = 0; i < defs.size(); i++) {
+		Emitter *e = new Emitter(new SpriteSystem());
+		e->drawable = false;
+		e->setChildSize(defs[i].width, defs[i].height);
+		e->setLifespan(defs[i].lifespan * 1000);
+		e->rng.seed(seed, firstStream + i);
+		e->stop();
+		emitters.push_back(e);
+	}
+}
+
+void EmitterGroup::clear() {
+	for (Emitter *e : emitters) {
+		delete e->sys;
+		delete e;
+	}
+	emitters.clear();
+	defs.clear();
+}
+
+void EmitterGroup::start() {
+	for (Emitter *e : emitters) {
+		if (!e->started) e->start();
+	}
+}
+
+//  Randomize and update the emitters [first, last)
+//
+void EmitterGroup::update(const SimClock &clock, int first, int last, float worldWidth, float worldHeight, int score) {
+	for (int i = first; i < last; i++) {
+		aim(i, worldWidth, worldHeight, score);
+		emitters[i]->update(clock);
+	}
+}
+
+void EmitterGroup::setBounds(float w, float h, BoundsPolicy policy) {
+	for (Emitter *e : emitters) e->sys->setBounds(w, h, policy);
+}
+
+int EmitterGroup::getSpriteCount() const {
+	int count = 0;
+	for (const Emitter *e : emitters) count += e->sys->size();
+	return count;
+}
+
+//  Pick this tick's launch spot, velocity, direction and rate for
+//  emitter i
+//
+void EmitterGroup::aim(int i, float worldWidth, float worldHeight, int score) {
+	const EmitterDef &def = defs[i];
+	Emitter *e = emitters[i];
+
+	// dir points into the screen, corners move in on both axes
+	glm::vec3 pos, dir;
+	if (def.edge == EdgeCorner) {
+		int corner = (int)e->rng.uniform(0, 4);
+		bool right = corner & 1;
+		bool bottom = corner & 2;
+		pos = glm::vec3(right ? worldWidth : 0, bottom ? worldHeight : 0, 1);
+		dir = glm::vec3(right ? -1 : 1, bottom ? -1 : 1, 0);
+	}
+	else {
+		float along = e->rng.uniform(def.edgeMin, def.edgeMax);
+		int x = (int)(along * worldWidth);
+		int y = (int)(along * worldHeight);
+		switch (def.edge) {
+		case EdgeTop:
+			pos = glm::vec3(x, 0, 1);
+			dir = glm::vec3(0, 1, 0);
+			break;
+		case EdgeLeft:
+			pos = glm::vec3(0, y, 1);
+			dir = glm::vec3(1, 0, 0);
+			break;
+		case EdgeRight:
+			pos = glm::vec3(worldWidth, y, 1);
+			dir = glm::vec3(-1, 0, 0);
+			break;
+		default:
+			pos = glm::vec3(x, worldHeight, 1);
+			dir = glm::vec3(0, -1, 0);
+			break;
+		}
+	}
+	e->setPosition(pos);
+
+	// speed increases with score increase, random within a range. A
+	// fixed speed takes no draw, like the special wave always did.
+	int speed = def.speedMin == def.speedMax ? (int)def.speedMin : (int)e->rng.uniform(def.speedMin, def.speedMax);
+	glm::vec3 v = dir * (speed + def.speedPerPoint * score);
+	e->setVelocity(glm::vec3(v.x, v.y, 1));
+	// random direction within a range to provide some fun
+	int angle = (int)e->rng.uniform(def.angleMin, def.angleMax);
+	e->setFiringDir((float)angle);
+	e->setFiringMat((float)angle);
+	// random rate within a range, increases with score
+	float rate = e->rng.uniform(def.rateMin, def.rateMax);
+	e->setRate(rate + def.ratePerPoint * score);
+	e->setLifespan(def.lifespan * 1000);
+}
+
+std::vector<EmitterDef> EmitterGroup::getDefaults() {
+	std::vector<EmitterDef> waves(5);
+	waves[0].name = "top";
+	waves[0].edge = EdgeTop;
+	waves[1].name = "left";
+	waves[1].edge = EdgeLeft;
+	waves[2].name = "right";
+	waves[2].edge = EdgeRight;
+	waves[3].name = "bottom";
+	waves[3].edge = EdgeBottom;
+	for (int i = 0; i < 4; i++) waves[i].image = "images/P1_enemy.png";
+
+	// special invader: fast, from a corner, worth more
+	EmitterDef &special = waves[4];
+	special.name = "special";
+	special.edge = EdgeCorner;
+	special.speedMin = 1500;
+	special.speedMax = 1500;
+	special.rateMin = 0.14;
+	special.rateMax = 0.21;
+	special.ratePerPoint = 0;
+	special.points = 4;
+	special.image = "images/P1_whitehot.png";
+	special.width = 40;
+	special.height = 40;
+	return waves;
+}
@@ -0,0 +1,69 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include <string>
+#include <vector>
+#include "Emitter.h"
+
+// where on the screen a wave of invaders launches from
+typedef enum { EdgeTop, EdgeLeft, EdgeRight, EdgeBottom, EdgeCorner } SpawnEdge;
+
+//  Description of one wave of invaders. Every tick its emitter is moved
+//  to a random spot on its edge (or a random corner) and given a random
+//  speed into the screen, direction and rate from these ranges. Speed
+//  and rate go up with the score.
+//
+struct EmitterDef {
+	std::string name;
+	SpawnEdge edge = EdgeTop;
+	float edgeMin = 0.05;  // part of the edge it launches from, 0 to 1
+	float edgeMax = 0.95;
+	float speedMin = 400;  // pixels/sec into the screen
+	float speedMax = 601;
+	float speedPerPoint = 0.75;
+	float angleMin = -45;  // degrees off straight in
+	float angleMax = 46;
+	float rateMin = 0.25;  // sprites/sec
+	float rateMax = 0.51;
+	float ratePerPoint = 1 / 500.0;
+	float lifespan = 4;    // seconds
+	int points = 1;        // score for each invader hit
+	std::string image;     // loaded by the front end, may be empty
+	float width = 60;      // size of the invaders when there is no image
+	float height = 60;
+};
+
+//  All invader emitters, one per definition. Each emitter owns its
+//  sprite system and random stream, so any range of them can be
+//  updated on its own thread.
+//
+class EmitterGroup {
+public:
+	EmitterGroup() {}
+	~EmitterGroup();
+	EmitterGroup(const EmitterGroup &) = delete;
+	EmitterGroup &operator=(const EmitterGroup &) = delete;
+
+	void setup(const std::vector<EmitterDef> &waves, uint32_t seed, int firstStream);
+	void clear();
+	void start();
+	void update(const SimClock &clock, int first, int last, float worldWidth, float worldHeight, int score);
+	void setBounds(float w, float h, BoundsPolicy policy);
+	int size() const { return emitters.size(); }
+	int getSpriteCount() const;
+
+	// the four edges and the corner wave the game has always had
+	static std::vector<EmitterDef> getDefaults();
+
+	std::vector<EmitterDef> defs;
+	std::vector<Emitter *> emitters; // emitters[i] is set up from defs[i]
+
+private:
+	void aim(int i, float worldWidth, float worldHeight, int score);
+};
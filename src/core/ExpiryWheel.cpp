@@ -0,0 +1,28 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "ExpiryWheel.h"
+
+ExpiryWheel::ExpiryWheel(int bucketCount) {
+	buckets.resize(bucketCount);
+	lastTick = -1;
+	count = 0;
+}
+
+//  Add an entry. One due on a tick that has already been handled goes
+//  in the next tick's bucket.
+//
+void ExpiryWheel::schedule(uint32_t id, uint32_t generation, int64_t expireTick) {
+	int64_t tick = expireTick > lastTick ? expireTick : lastTick + 1;
+	buckets[tick % buckets.size()].push_back({ id, generation, expireTick });
+	count++;
+}
+
+void ExpiryWheel::clear() {
+	for (std::vector<Entry> &bucket : buckets) bucket.clear();
+	count = 0;
+}
@@ -0,0 +1,64 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+//  Timing wheel of things waiting to expire, keyed on the tick they
+//  expire on. Each tick has a bucket (the tick modulo the number of
+//  buckets) so advancing the clock only looks at the buckets of the
+//  ticks that passed; entries more than one turn of the wheel away
+//  just stay in their bucket until their turn comes.
+//
+//  Entries are an id and a generation, so the owner can ignore entries
+//  for things it already removed some other way instead of having to
+//  find and cancel them.
+//
+class ExpiryWheel {
+public:
+	ExpiryWheel(int bucketCount = 1024);
+	void schedule(uint32_t id, uint32_t generation, int64_t expireTick);
+	void clear();
+	int size() const { return count; }
+
+	// call f(id, generation) for every entry due at or before tick now
+	template <class F> void advance(int64_t now, F f);
+
+private:
+	struct Entry {
+		uint32_t id;
+		uint32_t generation;
+		int64_t expireTick;
+	};
+	std::vector<std::vector<Entry>> buckets;
+	int64_t lastTick; // every tick up to here has been handled
+	int count;
+};
+
+template <class F>
+void ExpiryWheel::advance(int64_t now, F f) {
+	if (now <= lastTick) return;
+	// a jump longer than the wheel visits every bucket once
+	int64_t first = lastTick + 1;
+	if (now - first >= (int64_t)buckets.size()) first = now - buckets.size() + 1;
+
+	for (int64_t t = first; t <= now; t++) {
+		std::vector<Entry> &bucket = buckets[t % buckets.size()];
+		for (int i = 0; i < bucket.size();) {
+			if (bucket[i].expireTick <= now) {
+				f(bucket[i].id, bucket[i].generation);
+				bucket[i] = bucket.back();
+				bucket.pop_back();
+				count--;
+			}
+			else i++;
+		}
+	}
+	lastTick = now;
+}
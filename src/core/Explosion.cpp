@@ -0,0 +1,176 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "Explosion.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+// debris counts up to this have their share of the circle in a table
+#define DEBRIS_TABLE_MAX 100
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+// sine and cosine of x by their series, adding terms x^j / j! until
+// they stop changing either sum; good to double precision on [0, pi]
+struct SinCos {
+	double s, c;
+};
+constexpr SinCos seriesSinCos(double x) {
+	SinCos sum = { 0, 0 };
+	double term = 1;
+	for (int j = 0; sum.s + term != sum.s || sum.c + term != sum.c; j++) {
+		switch (j % 4) {
+		case 0: sum.c += term; break;
+		case 1: sum.s += term; break;
+		case 2: sum.c -= term; break;
+		default: sum.s -= term; break;
+		}
+		term *= x / (j + 1);
+	}
+	return sum;
+}
+
+// sine and cosine of an even share of the circle for n debris
+// particles, particle i points straight down rotated i shares
+struct DebrisTurns {
+	std::array<double, DEBRIS_TABLE_MAX + 1> s{}, c{};
+
+	constexpr DebrisTurns() {
+		for (int n = 1; n <= DEBRIS_TABLE_MAX; n++) {
+			// a whole turn is no turn
+			SinCos turn = seriesSinCos(n == 1 ? 0 : 2 * PI / n);
+			s[n] = turn.s;
+			c[n] = turn.c;
+		}
+	}
+};
+
+constexpr DebrisTurns debrisTurns;
+
+}
+
+ExplosionPool::ExplosionPool(int maxExplosions, int maxDebris) {
+	this->maxDebris = maxDebris;
+	debrisDamping = 0.99;
+	explosions.resize(maxExplosions);
+	x.resize(maxExplosions * maxDebris);
+	y.resize(maxExplosions * maxDebris);
+	vx.resize(maxExplosions * maxDebris);
+	vy.resize(maxExplosions * maxDebris);
+	fx.resize(maxExplosions * maxDebris);
+	fy.resize(maxExplosions * maxDebris);
+	live.reserve(maxExplosions);
+	liveIndex.resize(maxExplosions);
+	generation.resize(maxExplosions, 0);
+	freeSlots.reserve(maxExplosions);
+	clear();
+}
+
+// remove every explosion
+void ExplosionPool::clear() {
+	for (int slot : live) generation[slot]++;
+	live.clear();
+	freeSlots.clear();
+	expiry.clear();
+	// hand out low slots first
+	for (int slot = explosions.size() - 1; slot >= 0; slot--) {
+		freeSlots.push_back(slot);
+		liveIndex[slot] = -1;
+	}
+}
+
+//  Start an explosion at boomSite, with dust debris particles pushed
+//  outwards in a ring. Returns the slot used, or -1 if every slot is
+//  busy (the explosion is skipped).
+//
+int ExplosionPool::add(const SimClock &clock, glm::vec3 boomSite, int pts, float life, float power, int dust) {
+	if (freeSlots.empty()) return -1;
+	int slot = freeSlots.back();
+	freeSlots.pop_back();
+	liveIndex[slot] = live.size();
+	live.push_back(slot);
+
+	Explosion &e = explosions[slot];
+	e.trans = boomSite;
+	e.lifespan = clock.fromMillis(life * 1000);// 1500;
+	e.birthtime = clock.now();
+	e.debrisCount = std::min(std::max(dust, 0), maxDebris);// 20;
+	e.points = pts;
+	e.firstParticle = slot * maxDebris;
+	if (e.lifespan != -1) expiry.schedule(slot, generation[slot], e.birthtime + e.lifespan + 1);
+
+	// set up each particle that is part of explosion, the force points
+	// straight down rotated by an even share of the circle: each
+	// direction is the one before it turned by one share
+	int n = e.debrisCount;
+	double s = n <= DEBRIS_TABLE_MAX ? debrisTurns.s[n] : std::sin(2 * PI / n);
+	double c = n <= DEBRIS_TABLE_MAX ? debrisTurns.c[n] : std::cos(2 * PI / n);
+	double dx = 0;
+	double dy = 1;
+	for (int i = 0; i < n; i++) {
+		int p = e.firstParticle + i;
+		x[p] = boomSite.x;
+		y[p] = boomSite.y;
+		vx[p] = 0;
+		vy[p] = 0;
+		fx[p] = (float)dx * power * 1000;
+		fy[p] = (float)dy * power * 1000;
+		double rx = dx * c - dy * s;
+		dy = dy * c + dx * s;
+		dx = rx;
+	}
+	return slot;
+}
+
+//  Remove the i'th live explosion. The last live explosion takes its
+//  place in the live list.
+//
+void ExplosionPool::remove(int i) {
+	int slot = live[i];
+	freeSlots.push_back(slot);
+	liveIndex[slot] = -1;
+	generation[slot]++;
+	live[i] = live.back();
+	live.pop_back();
+	if (i < live.size()) liveIndex[live[i]] = i;
+}
+
+//  Remove the explosions that are older than their lifespan at tick
+//  now. Entries for slots that were freed since don't match the slot's
+//  generation any more and are skipped.
+//
+void ExplosionPool::removeExpired(int64_t now) {
+	expiry.advance(now, [this](uint32_t slot, uint32_t gen) {
+		if (generation[slot] == gen && liveIndex[slot] != -1) remove(liveIndex[slot]);
+	});
+}
+
+// integrate the debris of every live explosion
+void ExplosionPool::update(float dt) {
+	update(dt, 0, live.size());
+}
+
+//  Only touches the debris of the given live explosions, so separate
+//  ranges can be updated on separate threads
+//
+void ExplosionPool::update(float dt, int first, int last) {
+	for (int i = first; i < last; i++) {
+		const Explosion &e = explosions[live[i]];
+		int end = e.firstParticle + e.debrisCount;
+		for (int p = e.firstParticle; p < end; p++) {
+			x[p] += vx[p] * dt;
+			y[p] += vy[p] * dt;
+			vx[p] = (vx[p] + fx[p] * dt) * debrisDamping;
+			vy[p] = (vy[p] + fy[p] * dt) * debrisDamping;
+			fx[p] = 0;
+			fy[p] = 0;
+		}
+	}
+}
@@ -0,0 +1,59 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include <vector>
+#include "glm/glm.hpp"
+#include "ExpiryWheel.h"
+#include "SimClock.h"
+
+// one explosion, its debris particles live in the ExplosionPool
+struct Explosion {
+	int64_t age(int64_t now) const { return now - birthtime; }
+
+	glm::vec3 trans;
+	int64_t lifespan;  // in ticks
+	int64_t birthtime; // tick
+	int debrisCount;
+	int points;
+	int firstParticle; // index of its first debris particle in the pool
+};
+
+//  Fixed size storage for explosions and their debris. Every explosion
+//  slot owns a block of maxDebris particles, so adding an explosion
+//  just takes a free slot and fills its block, and removing one puts
+//  the slot back. Nothing is allocated after the pool is created.
+//
+class ExplosionPool {
+public:
+	ExplosionPool(int maxExplosions = 256, int maxDebris = 100);
+	int add(const SimClock &clock, glm::vec3 boomSite, int pts, float life, float power, int dust);
+	void remove(int i);
+	void removeExpired(int64_t now); // only touches the explosions due now
+	void update(float dt);
+	void update(float dt, int first, int last); // live explosions [first, last)
+	void clear();
+	int size() const { return live.size(); }
+	int capacity() const { return explosions.size(); }
+	const Explosion &get(int i) const { return explosions[live[i]]; }
+
+	// debris particles, index i of every array belongs to the same particle
+	std::vector<float> x, y;
+	std::vector<float> vx, vy;
+	std::vector<float> fx, fy; // force applied on the next integration
+	float debrisDamping;
+
+private:
+	std::vector<Explosion> explosions; // one per slot
+	std::vector<int> live;             // slots in use, in no particular order
+	std::vector<int> liveIndex;        // where each slot is in live, -1 if free
+	std::vector<uint32_t> generation;  // times each slot was freed
+	std::vector<int> freeSlots;
+	ExpiryWheel expiry;
+	int maxDebris;
+};
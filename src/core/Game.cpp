@@ -0,0 +1,258 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "Game.h"
+#include "Profiler.h"
+
+#define FIRERATE 20
+// explosions are only split across threads once there are enough of them
+#define BOOM_JOBS 4
+#define PARALLEL_BOOMS 16
+// the invader emitters are split into this many jobs
+#define INVADER_JOBS 4
+
+//  workers is the number of extra threads the simulation may use,
+//  -1 for one per spare core
+//
+Game::Game(int workers) : jobs(workers) {
+	projectiles = nullptr;
+	score = 0;
+	gameStarted = false;
+	width = 0;
+	height = 0;
+}
+
+Game::~Game() {
+	if (projectiles) {
+		delete projectiles->sys;
+		delete projectiles;
+	}
+}
+
+//  Create the ship and an invader emitter for every wave, for a play
+//  area of the given size. seed fixes the random spawn pattern of the
+//  invaders: every emitter draws from its own stream of it.
+//
+void Game::setup(float worldWidth, float worldHeight, uint32_t seed, const std::vector<EmitterDef> &waves) {
+	width = worldWidth;
+	height = worldHeight;
+	score = 0;
+
+	projectiles = new Emitter(new SpriteSystem());
+	projectiles->setPosition(glm::vec3(width / 2.0, height / 2.0, 1));
+	projectiles->drawable = true;                // make emitter itself visible
+	projectiles->setRate(0.001);
+	projectiles->stop(); // game initially is in idle state
+	projectiles->rng.seed(seed, 0);
+
+	invaders.setup(waves, seed, 1);
+
+	setWorldSize(width, height);
+	buildGraphs();
+}
+
+//  Resize the play area, the sprite systems apply the bounds policy
+//  from the settings to it
+//
+void Game::setWorldSize(float w, float h) {
+	width = w;
+	height = h;
+	if (projectiles) projectiles->sys->setBounds(width, height, settings.spriteBounds);
+	invaders.setBounds(width, height, settings.spriteBounds);
+}
+
+//  Build the tasks of one tick. Each emitter update only touches its
+//  own emitter, sprite system and random stream so they can all run
+//  at once; the collision check reads all of them and changes the
+//  score, so it waits for every one of them.
+//
+void Game::buildGraphs() {
+	stepGraph.clear();
+	int ship = stepGraph.add([this]() {
+		PROFILE_SCOPE(StageProjectiles);
+		projectiles->update(clock);
+	});
+	// every job randomizes and updates its share of the invader waves
+	std::vector<int> emitters = { ship };
+	for (int i = 0; i < INVADER_JOBS; i++) {
+		emitters.push_back(stepGraph.add([this, i]() {
+			PROFILE_JOB_SCOPE(StageInvaders);
+			int n = invaders.size();
+			invaders.update(clock, n * i / INVADER_JOBS, n * (i + 1) / INVADER_JOBS, width, height, score);
+		}));
+	}
+	int collisions = stepGraph.add([this]() {
+		PROFILE_SCOPE(StageCollisions);
+		checkCollisions();
+	});
+	for (int e : emitters) stepGraph.depend(collisions, e);
+
+	// each job integrates its own share of the live explosions
+	boomGraph.clear();
+	for (int i = 0; i < BOOM_JOBS; i++) {
+		boomGraph.add([this, i]() {
+			int n = booms.size();
+			booms.update(clock.getDt(), n * i / BOOM_JOBS, n * (i + 1) / BOOM_JOBS);
+		});
+	}
+}
+
+//  Add realSeconds of frame time and run as many fixed steps as it
+//  calls for, so the simulation doesn't depend on the frame rate
+//
+void Game::update(double realSeconds) {
+	int steps = clock.advance(realSeconds);
+	for (int i = 0; i < steps; i++) {
+		step();
+	}
+}
+
+//  Advance the whole game by one tick of the simulation clock
+//
+void Game::step() {
+	PROFILE_TICK();
+	clock.step();
+
+	// allows for ship to wrap around screen if goes out of bounds
+	{
+		PROFILE_SCOPE(StageShip);
+		if (projectiles->trans.x < 0) {
+			projectiles->setPosition(glm::vec3(width - 1, projectiles->trans.y, 1));
+		}
+		if (projectiles->trans.x > width) {
+			projectiles->setPosition(glm::vec3(1, projectiles->trans.y, 1));
+		}
+		if (projectiles->trans.y < 0) {
+			projectiles->setPosition(glm::vec3(projectiles->trans.x, height - 1, 1));
+		}
+		if (projectiles->trans.y > height) {
+			projectiles->setPosition(glm::vec3(projectiles->trans.x, 1, 1));
+		}
+
+		if (projectiles->started) projectiles->integrate(clock.getDt());
+	}
+
+	// update every emitter, then check collisions between projectiles
+	// and invaders
+	jobs.run(stepGraph);
+
+	// only update explosions if game starts
+	{
+		PROFILE_SCOPE(StageExplosions);
+		if (gameStarted) {
+			if (booms.size() >= PARALLEL_BOOMS) jobs.run(boomGraph);
+			else booms.update(clock.getDt());
+		}
+		removeBoom();
+	}
+
+	// hand the fire sounds of this tick to the front end
+	sounds.fire += projectiles->fireSoundCount;
+	projectiles->fireSoundCount = 0;
+
+	PROFILE_COUNT(CountProjectiles, projectiles->sys->size());
+	PROFILE_COUNT(CountInvaders, invaders.getSpriteCount());
+	PROFILE_COUNT(CountBooms, booms.size());
+	for (int i = 0; i < invaders.size(); i++) {
+		PROFILE_WAVE_COUNT(i, invaders.emitters[i]->sys->size());
+	}
+}
+
+// collision checking
+void Game::checkCollisions() {
+	// each wave is worth its own points, the special invader more
+	for (int i = 0; i < invaders.size(); i++) {
+		collide(invaders.emitters[i], invaders.defs[i].points);
+	}
+}
+
+// check every projectile against one set of invaders in a single
+// sweep, then apply the removals, score, explosions and sounds
+void Game::collide(Emitter *invaders, int points) {
+	// distance where projectile should count as collided with invader
+	float collisionDist = projectiles->childHeight / 2 + invaders->childHeight / 2;
+	SpriteSystem *shots = projectiles->sys;
+
+	hits.clear();
+	invaders->sys->findHits(shots->x.data(), shots->y.data(), shots->vx.data(), shots->vy.data(), shots->size(),
+		collisionDist, clock.getDt(), width, height, hits);
+
+	// hits are grouped by projectile, one explosion per projectile
+	int lastShot = -1;
+	for (const CollisionHit &hit : hits) {
+		score += points;
+		sounds.boom++;
+		if (hit.query != lastShot) {
+			addBoom(shots->getPosition(hit.query), points);
+			lastShot = hit.query;
+		}
+	}
+	invaders->sys->removeHits(hits);
+}
+
+// helper method to add explosion to perform
+void Game::addBoom(glm::vec3 boomPos, int thePts) {
+	booms.add(clock, boomPos, thePts, settings.boomLife, settings.boomPower, settings.boomDust);
+}
+
+// helper method to be put in update to remove expired booms
+void Game::removeBoom() {
+	booms.removeExpired(clock.now());
+}
+
+//  Fire button pressed. The first press starts the game by starting
+//  all emitters.
+//
+void Game::pressFire() {
+	if (!gameStarted) gameStarted = true;
+	// space starts the game by starting all emitters
+	if (!projectiles->started) projectiles->start();
+	invaders.start();
+
+	// resets the emitter lifespan, velocity, and rate to fire projectiles
+	projectiles->setVelocity(glm::vec3(0, FIRING_SPEED, 1));
+	projectiles->setRate(FIRERATE);
+	projectiles->setLifespan(LIFE);
+
+	// emit sound
+	if (projectiles->started) {
+		projectiles->playFireSound = true;
+	}
+}
+
+/*
+Overall idea is to hide emitted projectiles under the ship
+with no velocity and basically no lifespan
+to give illusion of stopped firing
+*/
+void Game::releaseFire() {
+	// projectiles to have no velocity and extreme low rate
+	projectiles->setVelocity(glm::vec3(0, 0, 0));
+	projectiles->setRate(0.001);
+	// lifespan needed to be reduced to avoid trailing 
+	// projectiles as my implementation
+	// does not stop drawing the projectiles
+	projectiles->setLifespan(0);
+
+	// stop sound
+	projectiles->playFireSound = false;
+}
+
+//  Push the ship along (x, y) in its own frame, (0, -1) is forward
+//
+void Game::thrust(float x, float y) {
+	if (projectiles->started)
+		projectiles->moveForces = projectiles->emitterRot.rotate(glm::vec3(x * settings.shipThrust, y * settings.shipThrust, 0));
+}
+
+//  Rotate the ship, dir 1 is clockwise and -1 counterclockwise
+//
+void Game::spin(float dir) {
+	if (projectiles->started) {
+		projectiles->moveRotForces = dir * settings.shipThrust;
+	}
+}
@@ -0,0 +1,85 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include <vector>
+#include "Emitter.h"
+#include "EmitterGroup.h"
+#include "Explosion.h"
+#include "JobSystem.h"
+#include "SimClock.h"
+
+// values the player can tweak while playing (the sliders in the app)
+struct GameSettings {
+	float shipThrust = 2000;
+	float boomPower = 15;
+	float boomLife = 1.5;
+	int boomDust = 50;
+	// what sprites do once they fly off the screen
+	BoundsPolicy spriteBounds = BoundsDespawn;
+};
+
+// sounds the simulation asked for since the front end last played them
+struct SoundEvents {
+	int fire = 0;
+	int boom = 0;
+};
+
+//  The whole game without any window, drawing or audio: the ship and
+//  its projectiles, the invader emitters, collisions, scoring and
+//  explosions. A front end feeds it input and frame time and reads its
+//  state back to draw and play sounds; a headless driver can just call
+//  step() in a loop.
+//
+class Game {
+public:
+	Game(int workers = -1);
+	~Game();
+	Game(const Game &) = delete;
+	Game &operator=(const Game &) = delete;
+
+	void setup(float worldWidth, float worldHeight, uint32_t seed,
+		const std::vector<EmitterDef> &waves = EmitterGroup::getDefaults());
+	void setWorldSize(float w, float h);
+	void update(double realSeconds);
+	void step();
+	void buildGraphs();
+	void checkCollisions();
+	void collide(Emitter *invaders, int points);
+
+	// input
+	void pressFire();
+	void releaseFire();
+	void thrust(float x, float y);
+	void spin(float dir);
+
+	// Explosion stuff
+	void addBoom(glm::vec3 boomPos, int thePts);
+	void removeBoom();
+	ExplosionPool booms;
+	std::vector<CollisionHit> hits;
+
+	Emitter *projectiles;
+	// every wave of invaders
+	EmitterGroup invaders;
+
+	// every part of the simulation reads time from here
+	SimClock clock;
+	GameSettings settings;
+	SoundEvents sounds;
+
+	int score;
+	bool gameStarted;
+	float width, height;
+
+	// the emitters only touch their own sprites until collisions, so
+	// their updates run in parallel, then explosions are split up
+	JobSystem jobs;
+	TaskGraph stepGraph;
+	TaskGraph boomGraph;
+};
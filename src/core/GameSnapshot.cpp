@@ -0,0 +1,114 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "GameSnapshot.h"
+#include <algorithm>
+#include <cmath>
+
+// copy every sprite of sys
+void SpriteSnapshot::copy(const SpriteSystem &sys) {
+	x.assign(sys.x.begin(), sys.x.end());
+	y.assign(sys.y.begin(), sys.y.end());
+	vx.assign(sys.vx.begin(), sys.vx.end());
+	vy.assign(sys.vy.begin(), sys.vy.end());
+	width.assign(sys.width.begin(), sys.width.end());
+	height.assign(sys.height.begin(), sys.height.end());
+	image.assign(sys.image.begin(), sys.image.end());
+}
+
+// the ship alpha of the way from its last pose to this one
+Transform2D ShipSnapshot::getTransform(float alpha) const {
+	Transform2D t = Transform2D::rotation(jumped ? rot : glm::mix(lastRot, rot, alpha));
+	glm::vec3 pos = jumped ? trans : glm::mix(lastTrans, trans, alpha);
+	t.tx = pos.x;
+	t.ty = pos.y;
+	return t;
+}
+
+//  Copy the state of game after its last tick. lastShipTrans and
+//  lastShipRot are the ship's pose before that tick.
+//
+void GameSnapshot::copy(const Game &game, glm::vec3 lastShipTrans, float lastShipRot) {
+	tick = game.clock.now();
+	dt = game.clock.getDt();
+	alpha = std::min(game.clock.getAlpha(), 1.0f);
+	tickSeconds = dt / std::max(game.clock.timeScale, 1e-6);
+	copied = std::chrono::steady_clock::now();
+	score = game.score;
+	gameStarted = game.gameStarted;
+
+	const Emitter &e = *game.projectiles;
+	ship.trans = e.trans;
+	ship.lastTrans = lastShipTrans;
+	ship.rot = e.rot;
+	ship.lastRot = lastShipRot;
+	ship.width = e.width;
+	ship.height = e.height;
+	ship.image = e.image;
+	ship.haveImage = e.haveImage;
+	ship.drawable = e.drawable;
+	ship.jumped = std::fabs(e.trans.x - lastShipTrans.x) > game.width / 2 ||
+		std::fabs(e.trans.y - lastShipTrans.y) > game.height / 2;
+
+	systems.resize(game.invaders.size() + 1);
+	systems[0].copy(*e.sys);
+	for (int i = 0; i < game.invaders.size(); i++) {
+		systems[i + 1].copy(*game.invaders.emitters[i]->sys);
+	}
+
+	// the debris of every live explosion, packed one after another
+	const ExplosionPool &pool = game.booms;
+	booms.resize(pool.size());
+	int particles = 0;
+	for (int i = 0; i < pool.size(); i++) particles += pool.get(i).debrisCount;
+	debrisX.resize(particles);
+	debrisY.resize(particles);
+	debrisVx.resize(particles);
+	debrisVy.resize(particles);
+	int next = 0;
+	for (int i = 0; i < pool.size(); i++) {
+		const Explosion &boom = pool.get(i);
+		booms[i] = boom;
+		booms[i].firstParticle = next;
+		int first = boom.firstParticle;
+		int n = boom.debrisCount;
+		std::copy(pool.x.begin() + first, pool.x.begin() + first + n, debrisX.begin() + next);
+		std::copy(pool.y.begin() + first, pool.y.begin() + first + n, debrisY.begin() + next);
+		std::copy(pool.vx.begin() + first, pool.vx.begin() + first + n, debrisVx.begin() + next);
+		std::copy(pool.vy.begin() + first, pool.vy.begin() + first + n, debrisVy.begin() + next);
+		next += n;
+	}
+}
+
+// how far drawing at time now is between the tick before this one and
+// this one, carrying on from the part of a tick already run ahead
+float GameSnapshot::getAlpha(std::chrono::steady_clock::time_point now) const {
+	double since = std::chrono::duration<double>(now - copied).count();
+	return (float)std::min(std::max(alpha + since / tickSeconds, 0.0), 1.0);
+}
+
+//  Make the back buffer the newest snapshot, the old ready buffer
+//  becomes the next back buffer
+//
+void SnapshotBuffer::publish() {
+	std::lock_guard<std::mutex> guard(lock);
+	std::swap(back, ready);
+	fresh = true;
+}
+
+//  Take the newest snapshot if one was published since the last call,
+//  otherwise keep the one already taken
+//
+const GameSnapshot *SnapshotBuffer::acquire() {
+	std::lock_guard<std::mutex> guard(lock);
+	if (fresh) {
+		std::swap(front, ready);
+		fresh = false;
+		published = true;
+	}
+	return published ? &buffers[front] : nullptr;
+}
@@ -0,0 +1,90 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include "Game.h"
+
+//  One sprite system's sprites as of a tick
+//
+struct SpriteSnapshot {
+	void copy(const SpriteSystem &sys);
+	int size() const { return x.size(); }
+
+	std::vector<float> x, y;
+	std::vector<float> vx, vy;
+	std::vector<float> width, height;
+	std::vector<ImageHandle> image;
+};
+
+//  The ship as of a tick and the tick before it
+//
+struct ShipSnapshot {
+	Transform2D getTransform(float alpha) const;
+
+	glm::vec3 trans, lastTrans;
+	float rot, lastRot;
+	float width, height;
+	ImageHandle image;
+	bool haveImage;
+	bool drawable;
+	bool jumped; // wrapped to the other side this tick, so not interpolated
+};
+
+//  Everything the front end draws, copied out of the game at the end
+//  of a tick so it can be drawn while the next ticks run. Drawing is
+//  one tick behind the simulation and alpha of the way from the tick
+//  before to this one: the ship's last pose is kept, sprites and
+//  debris are moved back along their velocity.
+//
+struct GameSnapshot {
+	void copy(const Game &game, glm::vec3 lastShipTrans, float lastShipRot);
+	float getAlpha(std::chrono::steady_clock::time_point now) const;
+	float getLag(float alpha) const { return (1 - alpha) * dt; } // seconds to move back
+
+	int64_t tick;
+	float dt;
+	float alpha;       // of a tick already run ahead when this was copied
+	double tickSeconds; // real seconds per tick
+	std::chrono::steady_clock::time_point copied;
+
+	int score;
+	bool gameStarted;
+	ShipSnapshot ship;
+	std::vector<SpriteSnapshot> systems; // projectiles, then every invader wave
+
+	// live explosions, their firstParticle indexes the debris arrays
+	std::vector<Explosion> booms;
+	std::vector<float> debrisX, debrisY;
+	std::vector<float> debrisVx, debrisVy;
+};
+
+//  Triple buffer of snapshots passed from the simulation thread to the
+//  drawing thread. The simulation fills the back buffer and publishes
+//  it, the drawer takes the newest published one and keeps reading it
+//  until it takes another. Neither side ever waits for the other to
+//  finish with a buffer, and the buffers are reused so their arrays
+//  stop reallocating once the sprite counts settle.
+//
+class SnapshotBuffer {
+public:
+	GameSnapshot &getBack() { return buffers[back]; } // simulation thread only
+	void publish();
+	const GameSnapshot *acquire(); // newest snapshot, nullptr before the first
+
+private:
+	GameSnapshot buffers[3];
+	std::mutex lock;
+	int back = 0;
+	int ready = 1;
+	int front = 2;
+	bool fresh = false;     // ready holds a snapshot the drawer hasn't taken
+	bool published = false; // front holds a snapshot
+};
@@ -0,0 +1,16 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include <cstdint>
+
+// small handle used by sprites and emitters to refer to a loaded image
+// instead of each holding their own copy of the pixels and texture.
+// The images themselves are owned by the front end (ImageRegistry).
+typedef uint16_t ImageHandle;
+const ImageHandle NO_IMAGE = 0xffff;
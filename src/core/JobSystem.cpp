@@ -0,0 +1,167 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "JobSystem.h"
+#include <algorithm>
+
+int TaskGraph::add(std::function<void()> work) {
+	tasks.emplace_back();
+	tasks.back().work = work;
+	return tasks.size() - 1;
+}
+
+void TaskGraph::depend(int task, int on) {
+	tasks[on].next.push_back(task);
+	tasks[task].deps++;
+}
+
+void TaskGraph::clear() {
+	tasks.clear();
+}
+
+JobSystem::JobSystem(int workers) {
+	current = nullptr;
+	generation = 0;
+	busyWorkers = 0;
+	stopping = false;
+
+	if (workers < 0) {
+		int cores = std::thread::hardware_concurrency();
+		workers = std::min(std::max(cores - 2, 0), MAX_DEFAULT_WORKERS);
+	}
+	queues = std::vector<Queue>(workers + 1);
+	for (int i = 1; i <= workers; i++) {
+		threads.emplace_back(&JobSystem::workerLoop, this, i);
+	}
+}
+
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread &t : threads) t.join();
+}
+
+//  Queue every task without dependencies, wake the workers and help
+//  them until the whole graph is done. The graph is only handed back
+//  once no worker is looking at it any more, so it can be run again.
+//
+void JobSystem::run(TaskGraph &graph) {
+	if (graph.tasks.empty()) return;
+
+	graph.pending = graph.tasks.size();
+	for (TaskGraph::Task &t : graph.tasks) t.waiting = t.deps;
+	int next = 0;
+	for (TaskGraph::Task &t : graph.tasks) {
+		if (t.deps == 0) {
+			push(next, &t);
+			next = (next + 1) % queues.size();
+		}
+	}
+
+	if (!threads.empty()) {
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			current = &graph;
+			generation++;
+		}
+		wake.notify_all();
+	}
+
+	work(0, graph);
+
+	if (!threads.empty()) {
+		std::unique_lock<std::mutex> guard(lock);
+		current = nullptr;
+		idle.wait(guard, [this]() { return busyWorkers == 0; });
+	}
+}
+
+void JobSystem::workerLoop(int index) {
+	unsigned int seen = 0;
+	while (true) {
+		TaskGraph *graph;
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			wake.wait(guard, [&]() { return stopping || generation != seen; });
+			if (stopping) return;
+			seen = generation;
+			// the graph may already be finished if this worker woke late
+			graph = current;
+			if (graph == nullptr) continue;
+			busyWorkers++;
+		}
+
+		work(index, *graph);
+
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			busyWorkers--;
+		}
+		idle.notify_one();
+	}
+}
+
+//  Run tasks from this thread's queue, or stolen ones, until every
+//  task of the graph has finished
+//
+void JobSystem::work(int index, TaskGraph &graph) {
+	while (graph.pending > 0) {
+		// a task pushed after this was read can't be missed below
+		unsigned int seen = pushes;
+		TaskGraph::Task *task = pop(index);
+		if (task == nullptr) task = steal(index);
+		if (task == nullptr) {
+			std::unique_lock<std::mutex> guard(lock);
+			ready.wait(guard, [&]() { return pushes != seen || graph.pending == 0; });
+			continue;
+		}
+
+		task->work();
+		for (int n : task->next) {
+			TaskGraph::Task &follower = graph.tasks[n];
+			if (--follower.waiting == 0) push(index, &follower);
+		}
+		if (--graph.pending == 0) {
+			// under the lock so a thread about to sleep sees it's done
+			std::lock_guard<std::mutex> guard(lock);
+			ready.notify_all();
+		}
+	}
+}
+
+void JobSystem::push(int index, TaskGraph::Task *task) {
+	{
+		std::lock_guard<std::mutex> guard(queues[index].lock);
+		queues[index].tasks.push_back(task);
+	}
+	std::lock_guard<std::mutex> guard(lock);
+	pushes++;
+	ready.notify_all();
+}
+
+TaskGraph::Task *JobSystem::pop(int index) {
+	std::lock_guard<std::mutex> guard(queues[index].lock);
+	if (queues[index].tasks.empty()) return nullptr;
+	TaskGraph::Task *task = queues[index].tasks.back();
+	queues[index].tasks.pop_back();
+	return task;
+}
+
+TaskGraph::Task *JobSystem::steal(int index) {
+	for (int i = 1; i < queues.size(); i++) {
+		Queue &victim = queues[(index + i) % queues.size()];
+		std::lock_guard<std::mutex> guard(victim.lock);
+		if (victim.tasks.empty()) continue;
+		TaskGraph::Task *task = victim.tasks.front();
+		victim.tasks.pop_front();
+		return task;
+	}
+	return nullptr;
+}
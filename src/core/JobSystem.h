@@ -0,0 +1,92 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// no graph of a tick has more tasks that can run at once than the
+// calling thread plus this many workers
+#define MAX_DEFAULT_WORKERS 4
+
+//  A set of jobs and the order they have to run in. A graph is built
+//  once and can be run again every tick; running it only resets the
+//  dependency counts.
+//
+class TaskGraph {
+public:
+	int add(std::function<void()> work);
+	void depend(int task, int on); // task only starts once on has finished
+	void clear();
+	int size() const { return tasks.size(); }
+
+private:
+	friend class JobSystem;
+	struct Task {
+		std::function<void()> work;
+		std::vector<int> next;          // tasks waiting on this one
+		int deps = 0;                   // number of tasks this one waits on
+		std::atomic<int> waiting{ 0 };  // deps not finished in the current run
+	};
+	// deque so tasks never move once added
+	std::deque<Task> tasks;
+	std::atomic<int> pending{ 0 };
+};
+
+//  Small work stealing job system. Every worker thread, and the thread
+//  calling run(), has its own queue of ready tasks. A thread takes new
+//  work from the back of its own queue and, when that is empty, steals
+//  from the front of another thread's queue. A finished task pushes the
+//  tasks that were only waiting on it onto the queue of the thread that
+//  ran it.
+//
+class JobSystem {
+public:
+	// workers < 0 starts one worker per core besides the calling thread
+	// and the drawing thread, at most MAX_DEFAULT_WORKERS; 0 runs every
+	// graph on the calling thread alone
+	JobSystem(int workers = -1);
+	~JobSystem();
+	JobSystem(const JobSystem &) = delete;
+	JobSystem &operator=(const JobSystem &) = delete;
+
+	void run(TaskGraph &graph); // returns once every task has finished
+	int getWorkerCount() const { return threads.size(); }
+
+private:
+	struct Queue {
+		std::mutex lock;
+		std::deque<TaskGraph::Task *> tasks;
+	};
+	void workerLoop(int index);
+	void work(int index, TaskGraph &graph);
+	void push(int index, TaskGraph::Task *task);
+	TaskGraph::Task *pop(int index);
+	TaskGraph::Task *steal(int index);
+
+	std::vector<std::thread> threads;
+	std::vector<Queue> queues; // queue 0 belongs to the thread calling run()
+
+	// workers sleep until a new graph is started or they are told to stop
+	std::mutex lock;
+	std::condition_variable wake;
+	std::condition_variable idle;
+	// a thread that finds no task sleeps until one is pushed or the
+	// graph is done, instead of spinning through serial tasks
+	std::condition_variable ready;
+	std::atomic<unsigned int> pushes{ 0 };
+	TaskGraph *current;
+	unsigned int generation;
+	int busyWorkers;
+	bool stopping;
+};
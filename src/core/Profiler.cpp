@@ -0,0 +1,206 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "Profiler.h"
+#include <algorithm>
+#include <cstdio>
+
+static const char *stageNames[StageCount] = {
+	"update", "ship", "projectiles", "invaders",
+	"collisions", "explosions",
+	"draw", "draw sprites", "draw explosions", "draw text"
+};
+
+static const char *counterNames[CounterCount] = {
+	"projectiles", "invaders", "booms"
+};
+
+Profiler &Profiler::get() {
+	static Profiler profiler;
+	return profiler;
+}
+
+Profiler::Profiler(int capacity) {
+	frames.reset(capacity);
+	ticks.reset(capacity);
+	currentFrame = Record();
+	currentTick = Record();
+}
+
+void Profiler::reset(int capacity) {
+	std::lock_guard<std::mutex> guard(lock);
+	frames.reset(capacity);
+	ticks.reset(capacity);
+}
+
+void Profiler::beginFrame() {
+	std::lock_guard<std::mutex> guard(lock);
+	currentFrame = Record();
+}
+
+void Profiler::endFrame() {
+	std::lock_guard<std::mutex> guard(lock);
+	frames.push(currentFrame);
+}
+
+void Profiler::beginTick() {
+	std::lock_guard<std::mutex> guard(lock);
+	currentTick = Record();
+}
+
+void Profiler::endTick() {
+	std::lock_guard<std::mutex> guard(lock);
+	ticks.push(currentTick);
+}
+
+void Profiler::add(ProfileStage stage, double ms) {
+	std::lock_guard<std::mutex> guard(lock);
+	Record &record = isTickStage(stage) ? currentTick : currentFrame;
+	record.stageMs[stage] += ms;
+}
+
+void Profiler::addJob(ProfileStage stage, double ms) {
+	std::lock_guard<std::mutex> guard(lock);
+	Record &record = isTickStage(stage) ? currentTick : currentFrame;
+	record.stageMs[stage] = std::max(record.stageMs[stage], ms);
+}
+
+void Profiler::setCount(ProfileCounter counter, int value) {
+	std::lock_guard<std::mutex> guard(lock);
+	currentTick.counts[counter] = value;
+}
+
+void Profiler::setWaveCount(int wave, int value) {
+	if (wave < 0 || wave >= MAX_PROFILED_WAVES) return;
+	std::lock_guard<std::mutex> guard(lock);
+	currentTick.waveCounts[wave] = value;
+}
+
+void Profiler::History::reset(int capacity) {
+	records.assign(capacity, Record());
+	next = 0;
+	filled = 0;
+}
+
+// store a finished record, overwriting the oldest once the buffer is full
+void Profiler::History::push(const Record &record) {
+	records[next] = record;
+	next = (next + 1) % records.size();
+	if (filled < records.size()) filled++;
+}
+
+const Profiler::Record &Profiler::History::get(int i) const {
+	int oldest = (next - filled + records.size()) % records.size();
+	return records[(oldest + i) % records.size()];
+}
+
+const Profiler::History &Profiler::getHistory(ProfileStage stage) const {
+	return isTickStage(stage) ? ticks : frames;
+}
+
+int Profiler::getFrameCount() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return frames.filled;
+}
+
+int Profiler::getTickCount() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return ticks.filled;
+}
+
+// time of a stage (ms) that p percent of the recorded frames or ticks
+// stay under
+double Profiler::getPercentile(ProfileStage stage, double p) const {
+	std::lock_guard<std::mutex> guard(lock);
+	const History &history = getHistory(stage);
+	if (history.filled == 0) return 0;
+	scratch.resize(history.filled);
+	for (int i = 0; i < history.filled; i++) scratch[i] = history.get(i).stageMs[stage];
+	int k = std::min((int)(p / 100.0 * history.filled), history.filled - 1);
+	std::nth_element(scratch.begin(), scratch.begin() + k, scratch.end());
+	return scratch[k];
+}
+
+double Profiler::getMax(ProfileStage stage) const {
+	std::lock_guard<std::mutex> guard(lock);
+	const History &history = getHistory(stage);
+	double most = 0;
+	for (int i = 0; i < history.filled; i++) most = std::max(most, history.get(i).stageMs[stage]);
+	return most;
+}
+
+int Profiler::getLastCount(ProfileCounter counter) const {
+	std::lock_guard<std::mutex> guard(lock);
+	if (ticks.filled == 0) return 0;
+	return ticks.get(ticks.filled - 1).counts[counter];
+}
+
+int Profiler::getLastWaveCount(int wave) const {
+	std::lock_guard<std::mutex> guard(lock);
+	if (ticks.filled == 0 || wave < 0 || wave >= MAX_PROFILED_WAVES) return 0;
+	return ticks.get(ticks.filled - 1).waveCounts[wave];
+}
+
+int Profiler::getPeakCount(ProfileCounter counter) const {
+	std::lock_guard<std::mutex> guard(lock);
+	int most = 0;
+	for (int i = 0; i < ticks.filled; i++) most = std::max(most, ticks.get(i).counts[counter]);
+	return most;
+}
+
+//  Write every recorded frame, oldest first, one row per frame with
+//  the times (ms) of the stages timed per frame. Then every recorded
+//  tick, one row per tick with the simulation stage times followed by
+//  the entity counts and the count of every profiled invader wave.
+//
+bool Profiler::writeCsv(const std::string &path) const {
+	FILE *file = fopen(path.c_str(), "w");
+	if (!file) return false;
+	std::lock_guard<std::mutex> guard(lock);
+
+	fprintf(file, "frame");
+	for (int s = 0; s < StageCount; s++) {
+		if (!isTickStage((ProfileStage)s)) fprintf(file, ",%s ms", stageNames[s]);
+	}
+	fprintf(file, "\n");
+	for (int i = 0; i < frames.filled; i++) {
+		const Record &frame = frames.get(i);
+		fprintf(file, "%d", i);
+		for (int s = 0; s < StageCount; s++) {
+			if (!isTickStage((ProfileStage)s)) fprintf(file, ",%.4f", frame.stageMs[s]);
+		}
+		fprintf(file, "\n");
+	}
+
+	fprintf(file, "\ntick");
+	for (int s = 0; s < StageCount; s++) {
+		if (isTickStage((ProfileStage)s)) fprintf(file, ",%s ms", stageNames[s]);
+	}
+	for (int c = 0; c < CounterCount; c++) fprintf(file, ",%s", counterNames[c]);
+	for (int w = 0; w < MAX_PROFILED_WAVES; w++) fprintf(file, ",wave %d", w);
+	fprintf(file, "\n");
+	for (int i = 0; i < ticks.filled; i++) {
+		const Record &tick = ticks.get(i);
+		fprintf(file, "%d", i);
+		for (int s = 0; s < StageCount; s++) {
+			if (isTickStage((ProfileStage)s)) fprintf(file, ",%.4f", tick.stageMs[s]);
+		}
+		for (int c = 0; c < CounterCount; c++) fprintf(file, ",%d", tick.counts[c]);
+		for (int w = 0; w < MAX_PROFILED_WAVES; w++) fprintf(file, ",%d", tick.waveCounts[w]);
+		fprintf(file, "\n");
+	}
+	fclose(file);
+	return true;
+}
+
+const char *Profiler::getStageName(ProfileStage stage) {
+	return stageNames[stage];
+}
+
+const char *Profiler::getCounterName(ProfileCounter counter) {
+	return counterNames[counter];
+}
@@ -0,0 +1,149 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// parts of a frame that get timed. The simulation stages, ship
+// through explosions, are timed per tick instead.
+typedef enum {
+	StageUpdate, StageShip, StageProjectiles, StageInvaders,
+	StageCollisions, StageExplosions,
+	StageDraw, StageDrawSprites, StageDrawExplosions, StageDrawText,
+	StageCount
+} ProfileStage;
+
+// entity counts recorded with every tick
+typedef enum {
+	CountProjectiles, CountInvaders, CountBooms,
+	CounterCount
+} ProfileCounter;
+
+// the sprite count of each of the first this many invader waves is
+// recorded too, the invaders counter holds the count of all of them
+#define MAX_PROFILED_WAVES 8
+
+//  Frame and tick profiler. Scoped timers add their time to the
+//  current frame, or to the current tick for the simulation stages.
+//  Finished frames and ticks each go into a ring buffer of their own
+//  holding the last few seconds, which the overlay reads percentiles
+//  from and which can be written out as CSV. The ticks run on the
+//  simulation thread, so a drawn frame may have any number of them;
+//  kept apart, a frame without a tick doesn't read as a tick that took
+//  no time. Timers may also run on job threads: a stage run as several
+//  jobs at once records its longest job, which is about how long the
+//  jobs held the tick up.
+//
+class Profiler {
+public:
+	static Profiler &get();
+	static bool isTickStage(ProfileStage stage) { return stage >= StageShip && stage <= StageExplosions; }
+
+	Profiler(int capacity = 600);
+	void reset(int capacity); // drop every record and keep up to capacity frames and ticks
+	void beginFrame();
+	void endFrame();
+	void beginTick();
+	void endTick();
+	void add(ProfileStage stage, double ms);
+	void addJob(ProfileStage stage, double ms); // one of several parallel jobs
+	void setCount(ProfileCounter counter, int value);
+	void setWaveCount(int wave, int value);
+
+	int getFrameCount() const;
+	int getTickCount() const;
+	// over the recorded frames, or ticks for the simulation stages
+	double getPercentile(ProfileStage stage, double p) const;
+	double getMax(ProfileStage stage) const;
+	// over the recorded ticks
+	int getLastCount(ProfileCounter counter) const;
+	int getPeakCount(ProfileCounter counter) const;
+	int getLastWaveCount(int wave) const;
+	bool writeCsv(const std::string &path) const;
+
+	static const char *getStageName(ProfileStage stage);
+	static const char *getCounterName(ProfileCounter counter);
+
+private:
+	struct Record {
+		double stageMs[StageCount];
+		int counts[CounterCount];
+		int waveCounts[MAX_PROFILED_WAVES];
+	};
+
+	// the last records of one kind, the oldest is overwritten once full
+	struct History {
+		void reset(int capacity);
+		void push(const Record &record);
+		const Record &get(int i) const; // i = 0 is the oldest
+
+		std::vector<Record> records;
+		int next = 0;   // where the next record goes
+		int filled = 0; // number of records, up to capacity
+	};
+	const History &getHistory(ProfileStage stage) const;
+
+	Record currentFrame;
+	Record currentTick;
+	History frames;
+	History ticks;
+	// ticks are recorded on the simulation thread, timers run on job
+	// threads and everything is read on the drawing thread
+	mutable std::mutex lock;
+	mutable std::vector<double> scratch;
+};
+
+//  Adds the time between its construction and destruction to a stage,
+//  as one of its parallel jobs if job is set
+//
+class ScopedTimer {
+public:
+	ScopedTimer(ProfileStage stage, bool job = false) {
+		this->stage = stage;
+		this->job = job;
+		start = std::chrono::steady_clock::now();
+	}
+	~ScopedTimer() {
+		std::chrono::duration<double, std::milli> ms = std::chrono::steady_clock::now() - start;
+		if (job) Profiler::get().addJob(stage, ms.count());
+		else Profiler::get().add(stage, ms.count());
+	}
+
+private:
+	ProfileStage stage;
+	bool job;
+	std::chrono::steady_clock::time_point start;
+};
+
+//  Opens a tick record for the stages and counts added while it lives
+//
+class ScopedTick {
+public:
+	ScopedTick() { Profiler::get().beginTick(); }
+	~ScopedTick() { Profiler::get().endTick(); }
+};
+
+// define SPACEGAME_NO_PROFILER to compile every timer out
+#ifdef SPACEGAME_NO_PROFILER
+#define PROFILE_TICK()
+#define PROFILE_SCOPE(stage)
+#define PROFILE_JOB_SCOPE(stage)
+#define PROFILE_COUNT(counter, value)
+#define PROFILE_WAVE_COUNT(wave, value)
+#else
+#define PROFILE_CONCAT2(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT2(a, b)
+#define PROFILE_TICK() ScopedTick PROFILE_CONCAT(profileTick, __LINE__)
+#define PROFILE_SCOPE(stage) ScopedTimer PROFILE_CONCAT(profileTimer, __LINE__)(stage)
+#define PROFILE_JOB_SCOPE(stage) ScopedTimer PROFILE_CONCAT(profileTimer, __LINE__)(stage, true)
+#define PROFILE_COUNT(counter, value) Profiler::get().setCount(counter, value)
+#define PROFILE_WAVE_COUNT(wave, value) Profiler::get().setWaveCount(wave, value)
+#endif
@@ -0,0 +1,29 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "RandomStream.h"
+
+#define PCG_MULTIPLIER 6364136223846793005ULL
+
+void RandomStream::seed(uint64_t masterSeed, uint64_t stream) {
+	state = 0;
+	increment = (stream << 1) | 1;
+	next();
+	state += masterSeed;
+	next();
+}
+
+//  Advance the 64 bit state and return a permuted 32 bit output
+//  (PCG XSH RR)
+//
+uint32_t RandomStream::next() {
+	uint64_t old = state;
+	state = old * PCG_MULTIPLIER + increment;
+	uint32_t shifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+	uint32_t rot = (uint32_t)(old >> 59);
+	return (shifted >> rot) | (shifted << ((32 - rot) & 31));
+}
@@ -0,0 +1,28 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include <cstdint>
+
+//  Small PCG32 random number generator. Generators built from the same
+//  seed but different stream numbers give independent sequences, so
+//  every emitter can own one and draw from it on any thread while a
+//  single master seed still fixes the whole game.
+//
+class RandomStream {
+public:
+	RandomStream(uint64_t masterSeed = 0, uint64_t stream = 0) { seed(masterSeed, stream); }
+	void seed(uint64_t masterSeed, uint64_t stream);
+	uint32_t next();
+	// uniform random number in [lo, hi), same range as ofRandom
+	float uniform(float lo, float hi) { return lo + (hi - lo) * (next() / 4294967296.0); }
+
+private:
+	uint64_t state;
+	uint64_t increment; // always odd, picks the stream
+};
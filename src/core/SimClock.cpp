@@ -0,0 +1,33 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "SimClock.h"
+
+SimClock::SimClock(int ticksPerSecond) {
+	this->ticksPerSecond = ticksPerSecond;
+	timeScale = 1.0;
+	maxStepsPerFrame = 8;
+	tick = 0;
+	accumulator = 0;
+}
+
+//  Add realSeconds of frame time and return how many fixed steps
+//  should run now. Time beyond maxStepsPerFrame steps is dropped.
+//
+int SimClock::advance(double realSeconds) {
+	double dt = 1.0 / ticksPerSecond;
+	accumulator += realSeconds * timeScale;
+	int steps = (int)(accumulator / dt);
+	if (steps > maxStepsPerFrame) {
+		steps = maxStepsPerFrame;
+		accumulator = 0;
+	}
+	else {
+		accumulator -= steps * dt;
+	}
+	return steps;
+}
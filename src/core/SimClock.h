@@ -0,0 +1,40 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include <cstdint>
+
+//  Simulation clock with a fixed time step. Time is counted in whole
+//  ticks (64 bit, so it never loses precision however long the game
+//  runs). Real frame time is added to an accumulator and the simulation
+//  is stepped once for every full tick it holds. timeScale lets the
+//  simulation run faster or slower than real time.
+//
+class SimClock {
+public:
+	SimClock(int ticksPerSecond = 60);
+	int advance(double realSeconds);
+	void step() { tick++; }
+	int64_t now() const { return tick; }
+	float getDt() const { return 1.0f / ticksPerSecond; }
+	int getTicksPerSecond() const { return ticksPerSecond; }
+	float getAlpha() const { return accumulator * ticksPerSecond; }
+	int64_t fromMillis(float ms) const { return (int64_t)(ms * ticksPerSecond / 1000.0 + 0.5); }
+	float toMillis(int64_t ticks) const { return ticks * 1000.0 / ticksPerSecond; }
+	float toSeconds(int64_t ticks) const { return (double)ticks / ticksPerSecond; }
+
+	double timeScale;
+	// most steps run for a single frame, so a long stall doesn't make
+	// the simulation spend the next frames catching up
+	int maxStepsPerFrame;
+
+private:
+	int ticksPerSecond;
+	int64_t tick;
+	double accumulator; // real seconds not yet simulated
+};
@@ -0,0 +1,100 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "SimThread.h"
+#include <algorithm>
+
+SimThread::SimThread(Game &game) : game(game) {
+}
+
+SimThread::~SimThread() {
+	stop();
+}
+
+void SimThread::start() {
+	if (isRunning()) return;
+	running = true;
+	thread = std::thread([this]() { loop(); });
+}
+
+void SimThread::stop() {
+	if (!isRunning()) return;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		running = false;
+	}
+	wake.notify_all();
+	thread.join();
+}
+
+void SimThread::post(std::function<void(Game &)> f) {
+	if (!isRunning()) {
+		f(game);
+		return;
+	}
+	std::lock_guard<std::mutex> guard(lock);
+	commands.push_back(std::move(f));
+}
+
+// sounds the game asked for since the last call
+SoundEvents SimThread::takeSounds() {
+	std::lock_guard<std::mutex> guard(lock);
+	SoundEvents taken = sounds;
+	sounds = SoundEvents();
+	return taken;
+}
+
+//  Run the ticks that real time calls for, publish a snapshot after
+//  them, then sleep until the next tick is due. The clock still drops
+//  time beyond maxStepsPerFrame ticks, so a stall doesn't turn into a
+//  burst of catching up.
+//
+void SimThread::loop() {
+	typedef std::chrono::steady_clock Clock;
+	Clock::time_point last = Clock::now();
+
+	while (running) {
+		// input posted since the last ticks, run outside the lock so
+		// the drawing thread can keep posting
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			runningCommands.swap(commands);
+		}
+		for (std::function<void(Game &)> &f : runningCommands) f(game);
+		runningCommands.clear();
+
+		Clock::time_point now = Clock::now();
+		int steps = game.clock.advance(std::chrono::duration<double>(now - last).count());
+		last = now;
+
+		if (steps > 0) {
+			glm::vec3 shipTrans;
+			float shipRot = 0;
+			for (int i = 0; i < steps; i++) {
+				shipTrans = game.projectiles->trans;
+				shipRot = game.projectiles->rot;
+				game.step();
+			}
+			snapshots.getBack().copy(game, shipTrans, shipRot);
+			snapshots.publish();
+
+			std::lock_guard<std::mutex> guard(lock);
+			sounds.fire += game.sounds.fire;
+			sounds.boom += game.sounds.boom;
+			game.sounds = SoundEvents();
+		}
+
+		// sleep for the rest of the tick the clock is part way through,
+		// at most one tick of real time so posted input still runs
+		// while the clock is slowed down or paused
+		double tick = game.clock.getDt() / std::max(game.clock.timeScale, 1e-6);
+		double wait = (1 - std::min(game.clock.getAlpha(), 1.0f)) * tick;
+		wait = std::min(wait, (double)game.clock.getDt());
+		std::unique_lock<std::mutex> guard(lock);
+		wake.wait_for(guard, std::chrono::duration<double>(wait), [this]() { return !running; });
+	}
+}
@@ -0,0 +1,58 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Game.h"
+#include "GameSnapshot.h"
+
+//  Runs a game on its own thread at the game clock's fixed tick, so a
+//  slow frame on the drawing thread doesn't hold the simulation up and
+//  a slow tick doesn't hold up drawing. After every batch of ticks the
+//  game is copied into a snapshot for drawing. Nothing outside the
+//  thread touches the game while it runs: input is posted as commands
+//  that run on the thread before its next tick, and sounds are handed
+//  back through takeSounds().
+//
+class SimThread {
+public:
+	SimThread(Game &game);
+	~SimThread();
+	SimThread(const SimThread &) = delete;
+	SimThread &operator=(const SimThread &) = delete;
+
+	void start();
+	void stop();
+	bool isRunning() const { return thread.joinable(); }
+
+	// runs f on the simulation thread before its next tick, or right
+	// away if the thread isn't running
+	void post(std::function<void(Game &)> f);
+	SoundEvents takeSounds();
+	const GameSnapshot *acquire() { return snapshots.acquire(); }
+
+private:
+	void loop();
+
+	Game &game;
+	std::thread thread;
+	std::atomic<bool> running{ false };
+
+	std::mutex lock;               // guards commands, sounds and wakes the thread
+	std::condition_variable wake;  // stop() cuts the wait for the next tick short
+	std::vector<std::function<void(Game &)>> commands;
+	std::vector<std::function<void(Game &)>> runningCommands;
+	SoundEvents sounds;
+
+	SnapshotBuffer snapshots;
+};
@@ -0,0 +1,71 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "SpatialGrid.h"
+#include <cmath>
+
+SpatialGrid::SpatialGrid() {
+	width = 0;
+	height = 0;
+	cellSize = 0;
+	cols = 0;
+	rows = 0;
+}
+
+//  Size the grid to cover the play area. Nothing is reallocated if the
+//  area and cell size haven't changed since the last call.
+//
+void SpatialGrid::setup(float worldWidth, float worldHeight, float size) {
+	size = std::max(size, 1.0f);
+	if (worldWidth == width && worldHeight == height && size == cellSize) return;
+
+	width = worldWidth;
+	height = worldHeight;
+	cellSize = size;
+	cols = std::max((int)std::ceil(width / cellSize), 1);
+	rows = std::max((int)std::ceil(height / cellSize), 1);
+	cellStart.assign(cols * rows + 1, 0);
+}
+
+int SpatialGrid::getCol(float x) const {
+	int col = (int)std::floor(x / cellSize);
+	return std::min(std::max(col, 0), cols - 1);
+}
+
+int SpatialGrid::getRow(float y) const {
+	int row = (int)std::floor(y / cellSize);
+	return std::min(std::max(row, 0), rows - 1);
+}
+
+//  Sort the n points into their cells (counting sort, linear in the
+//  number of points plus the number of cells)
+//
+void SpatialGrid::build(const float *x, const float *y, int n) {
+	int cells = cols * rows;
+	std::fill(cellStart.begin(), cellStart.end(), 0);
+	cellOf.resize(n);
+	entries.resize(n);
+
+	// count the points in each cell
+	for (int i = 0; i < n; i++) {
+		cellOf[i] = getRow(y[i]) * cols + getCol(x[i]);
+		cellStart[cellOf[i] + 1]++;
+	}
+	// turn the counts into start offsets
+	for (int c = 0; c < cells; c++) {
+		cellStart[c + 1] += cellStart[c];
+	}
+	// place each point, advancing its cell's start as the cell fills
+	for (int i = 0; i < n; i++) {
+		entries[cellStart[cellOf[i]]++] = i;
+	}
+	// placing shifted every start to the next cell's start, shift back
+	for (int c = cells; c > 0; c--) {
+		cellStart[c] = cellStart[c - 1];
+	}
+	cellStart[0] = 0;
+}
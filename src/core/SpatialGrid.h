@@ -0,0 +1,53 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+//  Uniform grid over the play area used to find sprites near a point
+//  without testing every sprite. The cell size should be at least the
+//  largest distance that will be searched, so only the 3x3 block of
+//  cells around a point has to be visited. Positions outside the area
+//  are clamped into the border cells.
+//
+class SpatialGrid {
+public:
+	SpatialGrid();
+	void setup(float worldWidth, float worldHeight, float cellSize);
+	void build(const float *x, const float *y, int n);
+	int getCol(float x) const;
+	int getRow(float y) const;
+
+	// call f(i) for every point index in the cells surrounding (px, py)
+	template <typename F>
+	void forEachNear(float px, float py, F f) const {
+		int col = getCol(px);
+		int row = getRow(py);
+		int c0 = std::max(col - 1, 0), c1 = std::min(col + 1, cols - 1);
+		int r0 = std::max(row - 1, 0), r1 = std::min(row + 1, rows - 1);
+		for (int r = r0; r <= r1; r++) {
+			// cells in a row are contiguous, so the whole span can be
+			// walked as one range of entries
+			int begin = cellStart[r * cols + c0];
+			int end = cellStart[r * cols + c1 + 1];
+			for (int e = begin; e < end; e++) f(entries[e]);
+		}
+	}
+
+private:
+	float width, height;
+	float cellSize;
+	int cols, rows;
+
+	// entries holds point indices sorted by cell, the points of cell c
+	// are entries[cellStart[c]] .. entries[cellStart[c + 1] - 1]
+	std::vector<int> cellStart;
+	std::vector<int> entries;
+	std::vector<int> cellOf;
+};
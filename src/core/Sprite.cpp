@@ -0,0 +1,301 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "Sprite.h"
+#include "SpriteKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+// grid cells for findHits are a multiple of this many pixels
+#define GRID_CELL_STEP 16
+
+//
+// Basic Sprite Object
+//
+Sprite::Sprite() {
+	speed = 0;
+	velocity = glm::vec3(0, 0, 0);
+	lifespan = -1;      // lifespan of -1 => immortal 
+	birthtime = 0;
+	bSelected = false;
+	haveImage = false;
+	image = NO_IMAGE;
+	name = "UnamedSprite";
+	width = 60;
+	height = 80;
+}
+
+//  Set an image for the sprite. If you don't set one, a rectangle
+//  gets drawn. Only the handle is stored, the image itself lives
+//  in the ImageRegistry.
+//
+void Sprite::setImage(ImageHandle img, float w, float h) {
+	image = img;
+	haveImage = true;
+	width = w;
+	height = h;
+}
+
+
+//  Make room for n sprites, so a burst of adds doesn't grow the
+//  arrays one step at a time
+//
+void SpriteSystem::reserve(int n) {
+	x.reserve(n);
+	y.reserve(n);
+	vx.reserve(n);
+	vy.reserve(n);
+	birthtime.reserve(n);
+	lifespan.reserve(n);
+	width.reserve(n);
+	height.reserve(n);
+	image.reserve(n);
+	slotOf.reserve(n);
+}
+
+//  Add a Sprite to the Sprite System and return a handle to it.
+//  A slot freed by an earlier removal is reused when there is one.
+//
+SpriteHandle SpriteSystem::add(const Sprite &s) {
+	uint32_t slot;
+	if (!freeSlots.empty()) {
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else {
+		slot = slots.size();
+		slots.push_back({ 0, 0 });
+	}
+	slots[slot].index = size();
+
+	x.push_back(s.trans.x);
+	y.push_back(s.trans.y);
+	vx.push_back(s.velocity.x);
+	vy.push_back(s.velocity.y);
+	birthtime.push_back(s.birthtime);
+	lifespan.push_back(s.lifespan);
+	width.push_back(s.width);
+	height.push_back(s.height);
+	image.push_back(s.haveImage ? s.image : NO_IMAGE);
+	slotOf.push_back(slot);
+
+	// expires on the first tick its age is past its lifespan
+	if (s.lifespan != -1) expiry.schedule(slot, slots[slot].generation, s.birthtime + s.lifespan + 1);
+	return { slot, slots[slot].generation };
+}
+
+// Remove a sprite from the sprite system. The last sprite is moved into
+// the hole so removal doesn't shift the rest of the arrays. The removed
+// sprite's slot is retired (generation bumped) and put on the free list.
+//
+void SpriteSystem::remove(int i) {
+	int last = size() - 1;
+	uint32_t slot = slotOf[i];
+	if (i != last) {
+		x[i] = x[last];
+		y[i] = y[last];
+		vx[i] = vx[last];
+		vy[i] = vy[last];
+		birthtime[i] = birthtime[last];
+		lifespan[i] = lifespan[last];
+		width[i] = width[last];
+		height[i] = height[last];
+		image[i] = image[last];
+		slotOf[i] = slotOf[last];
+		slots[slotOf[i]].index = i;
+	}
+	x.pop_back();
+	y.pop_back();
+	vx.pop_back();
+	vy.pop_back();
+	birthtime.pop_back();
+	lifespan.pop_back();
+	width.pop_back();
+	height.pop_back();
+	image.pop_back();
+	slotOf.pop_back();
+
+	slots[slot].generation++;
+	freeSlots.push_back(slot);
+}
+
+// Remove the sprite a handle refers to, if it is still alive
+//
+void SpriteSystem::remove(SpriteHandle h) {
+	int i = indexOf(h);
+	if (i != -1) remove(i);
+}
+
+// Current index of the sprite a handle refers to, or -1 if that
+// sprite has been removed
+//
+int SpriteSystem::indexOf(SpriteHandle h) const {
+	if (h.slot >= slots.size() || slots[h.slot].generation != h.generation) return -1;
+	return slots[h.slot].index;
+}
+
+// remove every sprite marked in flagged. Going from the back means the
+// sprite moved into each hole has already been checked.
+void SpriteSystem::removeFlagged() {
+	for (int i = size() - 1; i >= 0; i--) {
+		if (flagged[i]) remove(i);
+	}
+}
+
+// remove sprites at a given distance from point
+// return number removed
+int SpriteSystem::removeNear(glm::vec3 point, float dist) {
+	int n = size();
+	int count = 0;
+	flagged.assign(n, 0);
+	float distSq = dist * dist;
+
+	for (int i = 0; i < n; i++) {
+		float dx = x[i] - point.x;
+		float dy = y[i] - point.y;
+		if (dx * dx + dy * dy < distSq) {
+			flagged[i] = 1;
+			count++;
+		}
+	}
+	if (count > 0) removeFlagged();
+	return count;
+}
+
+// find every sprite that came within radius of any of the n query
+// points during the last step and append (query, sprite) pairs to
+// hits. Both moved in a straight line at their velocity, so their
+// closest approach is found on the segment between where they were
+// and where they are. Uses squared distances and a grid over the
+// world, so each point only tests sprites in the neighbouring cells.
+// A sprite that just wrapped looks like it came from outside the
+// opposite edge, which doesn't hit anything. A sprite is only reported
+// for the first query point (in order) that reaches it, so hits come
+// out grouped by query.
+void SpriteSystem::findHits(const float *qx, const float *qy, const float *qvx, const float *qvy, int n,
+	float radius, float dt, float worldWidth, float worldHeight, std::vector<CollisionHit> &hits) {
+	if (size() == 0 || n == 0) return;
+
+	// a point and a sprite can close in by at most this much during the
+	// step, so with cells that much bigger the cells around where the
+	// point ended up still hold every sprite it passed near. The size is
+	// rounded up so the grid isn't resized whenever the speeds change.
+	float maxPoint = 0;
+	float maxSprite = 0;
+	for (int q = 0; q < n; q++) maxPoint = std::max(maxPoint, qvx[q] * qvx[q] + qvy[q] * qvy[q]);
+	for (int i = 0; i < size(); i++) maxSprite = std::max(maxSprite, vx[i] * vx[i] + vy[i] * vy[i]);
+	float reach = (std::sqrt(maxPoint) + std::sqrt(maxSprite)) * dt;
+	float cellSize = std::ceil((radius + reach) / GRID_CELL_STEP) * GRID_CELL_STEP;
+
+	grid.setup(worldWidth, worldHeight, cellSize);
+	grid.build(x.data(), y.data(), size());
+	flagged.assign(size(), 0);
+	float radiusSq = radius * radius;
+
+	for (int q = 0; q < n; q++) {
+		float px = qx[q];
+		float py = qy[q];
+		grid.forEachNear(px, py, [&](int i) {
+			if (flagged[i]) return;
+			// where the sprite is relative to the point now, and how far
+			// it moved relative to the point during the step
+			float ex = x[i] - px;
+			float ey = y[i] - py;
+			float mx = (vx[i] - qvx[q]) * dt;
+			float my = (vy[i] - qvy[q]) * dt;
+			// closest they came: the relative position went from e - m
+			// to e in a straight line
+			float sx = ex - mx;
+			float sy = ey - my;
+			float moved = mx * mx + my * my;
+			float t = moved > 0 ? std::min(std::max(-(sx * mx + sy * my) / moved, 0.0f), 1.0f) : 1;
+			float dx = sx + mx * t;
+			float dy = sy + my * t;
+			if (dx * dx + dy * dy < radiusSq) {
+				flagged[i] = 1;
+				hits.push_back({ q, i });
+			}
+		});
+	}
+}
+
+// remove the sprites in a hit list from findHits. Removing from the
+// highest index down keeps the remaining indices in the list valid.
+void SpriteSystem::removeHits(const std::vector<CollisionHit> &hits) {
+	removeOrder.clear();
+	for (const CollisionHit &hit : hits) removeOrder.push_back(hit.target);
+	std::sort(removeOrder.begin(), removeOrder.end(), std::greater<int>());
+	for (int i : removeOrder) remove(i);
+}
+
+//  Update the SpriteSystem by checking which sprites have exceeded their
+//  lifespan (and deleting).  Also the sprite is moved to it's next
+//  location based on velocity and direction.
+//
+void SpriteSystem::update(const SimClock &clock) {
+
+	// only the sprites due this tick come out of the wheel; entries of
+	// sprites already removed some other way no longer match a handle
+	//
+	removeOrder.clear();
+	expiry.advance(clock.now(), [this](uint32_t slot, uint32_t generation) {
+		int i = indexOf({ slot, generation });
+		if (i != -1) removeOrder.push_back(i);
+	});
+	std::sort(removeOrder.begin(), removeOrder.end(), std::greater<int>());
+	for (int i : removeOrder) remove(i);
+
+	if (size() == 0) return;
+
+	//  Move sprite
+	//
+	integrateSprites(x.data(), y.data(), vx.data(), vy.data(), size(), clock.getDt());
+
+	// sprites that left the screen go away now rather than flying on
+	// until they expire
+	//
+	if (bounds != BoundsKeep) applyBounds();
+}
+
+//  Despawn or wrap every sprite that is entirely outside the bounds.
+//  Returns how many were removed.
+//
+int SpriteSystem::applyBounds() {
+	if (boundsWidth <= 0 || boundsHeight <= 0) return 0;
+
+	int outside = 0;
+	flagged.resize(size());
+	for (int i = 0; i < size(); i++) {
+		float hw = width[i] / 2;
+		float hh = height[i] / 2;
+		bool out = x[i] + hw < 0 || x[i] - hw > boundsWidth ||
+			y[i] + hh < 0 || y[i] - hh > boundsHeight;
+		flagged[i] = out;
+		outside += out;
+	}
+	if (outside == 0) return 0;
+
+	if (bounds == BoundsDespawn) {
+		removeFlagged();
+		return outside;
+	}
+
+	// wrap so the sprite comes back in just past the opposite edge
+	for (int i = 0; i < size(); i++) {
+		if (!flagged[i]) continue;
+		float spanX = boundsWidth + width[i];
+		float spanY = boundsHeight + height[i];
+		float hw = width[i] / 2;
+		float hh = height[i] / 2;
+		if (x[i] + hw < 0) x[i] += spanX;
+		else if (x[i] - hw > boundsWidth) x[i] -= spanX;
+		if (y[i] + hh < 0) y[i] += spanY;
+		else if (y[i] - hh > boundsHeight) y[i] -= spanY;
+	}
+	return 0;
+}
@@ -0,0 +1,125 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include <string>
+#include <vector>
+#include "BaseObject.h"
+#include "ExpiryWheel.h"
+#include "ImageHandle.h"
+#include "SimClock.h"
+#include "SpatialGrid.h"
+
+//  General Sprite class  (similar to a Particle)
+//
+class Sprite : public BaseObject {
+public:
+	Sprite();
+	int64_t age(int64_t now) const { return now - birthtime; }
+	void setImage(ImageHandle, float w, float h);
+	float speed;    //   in pixels/sec
+	glm::vec3 velocity; // in pixels/sec
+	ImageHandle image;
+	int64_t birthtime; // simulation tick the sprite was spawned on
+	int64_t lifespan;  // in ticks
+	std::string name;
+	bool haveImage;
+	float width, height;
+};
+
+//  Stable reference to a sprite in a SpriteSystem. Stays valid while the
+//  sprite is alive, even as other sprites are removed around it, and
+//  is detected as stale once its sprite is gone (the slot's generation
+//  no longer matches).
+//
+struct SpriteHandle {
+	uint32_t slot = 0;
+	uint32_t generation = 0;
+};
+
+//  A sprite found by SpriteSystem::findHits: query is the index of the
+//  query point that reached it, target the index of the sprite
+//
+struct CollisionHit {
+	int query;
+	int target;
+};
+
+// what happens to a sprite once it is completely outside the bounds:
+// left alone (it is still updated, only drawing skips it), removed, or
+// moved to the opposite edge
+typedef enum { BoundsKeep, BoundsDespawn, BoundsWrap } BoundsPolicy;
+
+//  Manages all Sprites in a system.  You can create multiple systems
+//  Sprites are stored as separate arrays (one per field) instead of a
+//  vector of Sprite objects, so update only touches the data it needs
+//  and can move several sprites at once. Removing a sprite moves the
+//  last sprite into its place, and a table of slots keeps handles
+//  pointing at the right index.
+//
+class SpriteSystem {
+public:
+	SpriteHandle add(const Sprite &);
+	void reserve(int n);
+	void remove(int);
+	void remove(SpriteHandle);
+	bool isValid(SpriteHandle h) const { return indexOf(h) != -1; }
+	int indexOf(SpriteHandle) const;
+	SpriteHandle getHandle(int i) const { return { slotOf[i], slots[slotOf[i]].generation }; }
+	void update(const SimClock &);
+	int removeNear(glm::vec3 point, float dist);
+	int size() const { return x.size(); }
+	int capacity() const { return x.capacity(); }
+	void setBounds(float w, float h, BoundsPolicy policy) { boundsWidth = w; boundsHeight = h; bounds = policy; }
+	BoundsPolicy getBoundsPolicy() const { return bounds; }
+
+	// collision checks against all query points at once: the sprites are
+	// put in a grid, each point only looks at the surrounding cells, and
+	// the hits are returned so they can be removed and scored afterwards.
+	// Points and sprites are swept along their velocity over the last dt
+	// seconds, so fast pairs that crossed during the step still hit.
+	void findHits(const float *qx, const float *qy, const float *qvx, const float *qvy, int n,
+		float radius, float dt, float worldWidth, float worldHeight, std::vector<CollisionHit> &hits);
+	void removeHits(const std::vector<CollisionHit> &hits);
+	glm::vec3 getPosition(int i) const { return glm::vec3(x[i], y[i], 1); }
+
+	// per sprite data, index i of every array belongs to the same sprite
+	std::vector<float> x, y;
+	std::vector<float> vx, vy;
+	std::vector<int64_t> birthtime; // tick spawned on
+	std::vector<int64_t> lifespan;  // in ticks, -1 => immortal
+	std::vector<float> width, height;
+	std::vector<ImageHandle> image; // NO_IMAGE => draw a rectangle
+	std::vector<uint32_t> slotOf;   // slot that refers back to this sprite
+
+private:
+	void removeFlagged();
+	int applyBounds();
+
+	// index into the sprite arrays for each slot, and a count of how
+	// many times the slot was freed so old handles can be told apart
+	struct Slot {
+		uint32_t index;
+		uint32_t generation;
+	};
+	std::vector<Slot> slots;
+	std::vector<uint32_t> freeSlots;
+
+	// area the sprites live in, (0, 0) to (boundsWidth, boundsHeight)
+	BoundsPolicy bounds = BoundsKeep;
+	float boundsWidth = 0;
+	float boundsHeight = 0;
+
+	// sprites with a lifespan, keyed on the tick they expire
+	ExpiryWheel expiry;
+
+	SpatialGrid grid;
+	std::vector<int> removeOrder;
+	// scratch array marking sprites to remove, kept to avoid reallocating
+	std::vector<unsigned char> flagged;
+};
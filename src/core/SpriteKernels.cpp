@@ -0,0 +1,45 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#include "SpriteKernels.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SPRITE_KERNEL_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SPRITE_KERNEL_SSE
+#endif
+
+void integrateSprites(float *x, float *y, const float *vx, const float *vy, int n, float dt) {
+	int i = 0;
+
+#if defined(SPRITE_KERNEL_AVX)
+	__m256 vdt = _mm256_set1_ps(dt);
+	for (; i + 8 <= n; i += 8) {
+		__m256 px = _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(_mm256_loadu_ps(vx + i), vdt));
+		__m256 py = _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(_mm256_loadu_ps(vy + i), vdt));
+		_mm256_storeu_ps(x + i, px);
+		_mm256_storeu_ps(y + i, py);
+	}
+#elif defined(SPRITE_KERNEL_SSE)
+	__m128 vdt = _mm_set1_ps(dt);
+	for (; i + 4 <= n; i += 4) {
+		__m128 px = _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(_mm_loadu_ps(vx + i), vdt));
+		__m128 py = _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(_mm_loadu_ps(vy + i), vdt));
+		_mm_storeu_ps(x + i, px);
+		_mm_storeu_ps(y + i, py);
+	}
+#endif
+
+	// scalar fallback, also picks up the sprites left over after the
+	// vector loop
+	for (; i < n; i++) {
+		x[i] += vx[i] * dt;
+		y[i] += vy[i] * dt;
+	}
+}
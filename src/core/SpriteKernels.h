@@ -0,0 +1,14 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+//  Move n sprites along their velocity by dt seconds. Runs 8 or 4
+//  sprites at a time with AVX or SSE when the compiler targets them,
+//  otherwise one at a time.
+//
+void integrateSprites(float *x, float *y, const float *vx, const float *vy, int n, float dt);
@@ -0,0 +1,49 @@
+/**
+
+	Author: Elston Ma
+	CS134
+	Project 1
+
+*/
+#pragma once
+
+#include <cmath>
+#include "glm/glm.hpp"
+
+//  Placement of an object in the plane: scale, then rotate, then
+//  translate. The rotation is kept as its cosine and sine so applying
+//  it is a few multiplies instead of a 4x4 matrix product.
+//
+struct Transform2D {
+	float c = 1, s = 0;   // cosine and sine of the rotation
+	float sx = 1, sy = 1; // scale
+	float tx = 0, ty = 0; // translation
+
+	// rotation by deg degrees, counterclockwise like glm::rotate about z
+	static Transform2D rotation(float deg) {
+		Transform2D t;
+		t.setRotation(deg);
+		return t;
+	}
+
+	void setRotation(float deg) {
+		float angle = glm::radians(deg);
+		c = std::cos(angle);
+		s = std::sin(angle);
+	}
+
+	// a point, scaled, rotated and moved
+	glm::vec2 apply(glm::vec2 p) const {
+		p.x *= sx;
+		p.y *= sy;
+		return glm::vec2(c * p.x - s * p.y + tx, s * p.x + c * p.y + ty);
+	}
+
+	// a direction, only rotated
+	glm::vec2 rotate(glm::vec2 v) const {
+		return glm::vec2(c * v.x - s * v.y, s * v.x + c * v.y);
+	}
+	glm::vec3 rotate(glm::vec3 v) const {
+		return glm::vec3(rotate(glm::vec2(v.x, v.y)), v.z);
+	}
+};
@@ -9,12 +9,18 @@
 #include "ofApp.h"
 
 //========================================================================
-int main( ){
+int main(int argc, char *argv[]){
+	// --stress runs the stress test scenario instead of a normal game
+	StressScenario scenario;
+	if (!scenario.parse(argc, argv)) return 1;
+
 	ofSetupOpenGL(1366,1024,OF_WINDOW);			// <-------- setup the GL context
+	ofApp *app = new ofApp();
+	app->scenario = scenario;
 
 	// this kicks off the running of my app
 	// can be OF_WINDOW or OF_FULLSCREEN
 	// pass in width and height too:
-	ofRunApp(new ofApp());
+	ofRunApp(app);
 
 }
@@ -8,547 +8,44 @@
 #include "ofApp.h"
 #define MOVEMENT_SPEED 1000
 #define ROT_SPEED 10
-#define FIRING_SPEED -1000
-#define LIFE 4000
-#define FIRERATE 20
-
-BaseObject::BaseObject() {
-	trans = glm::vec3(0, 0, 1);
-	scale = glm::vec3(1, 1, 1);
-	rot = 0;
-}
-
-void BaseObject::setPosition(glm::vec3 pos) {
-	trans = pos;
-}
-
-//
-// Basic Sprite Object
-//
-Sprite::Sprite() {
-	speed = 0;
-	velocity = glm::vec3(0, 0, 0);
-	lifespan = -1;      // lifespan of -1 => immortal 
-	birthtime = 0;
-	bSelected = false;
-	haveImage = false;
-	name = "UnamedSprite";
-	width = 60;
-	height = 80;
-}
-
-// Return a sprite's age in milliseconds
-//
-float Sprite::age() {
-	return (ofGetElapsedTimeMillis() - birthtime);
-}
-
-//  Set an image for the sprite. If you don't set one, a rectangle
-//  gets drawn.
-//
-void Sprite::setImage(ofImage img) {
-	image = img;
-	haveImage = true;
-	width = image.getWidth();
-	height = image.getHeight();
-}
-
-
-//  Render the sprite
-//
-void Sprite::draw() {
-
-	ofSetColor(255, 255, 255, 255);
-
-	// draw image centered and add in translation amount
-	//
-	if (haveImage) {
-		image.draw(-width / 2.0 + trans.x, -height / 2.0 + trans.y);
-	}
-	else {
-		// in case no image is supplied, draw something.
-		// 
-		ofSetColor(255, 0, 0);
-		ofDrawRectangle(-width / 2.0 + trans.x, -height / 2.0 + trans.y, width, height);
-	}
-}
-
-//  Add a Sprite to the Sprite System
-//
-void SpriteSystem::add(Sprite s) {
-	sprites.push_back(s);
-}
-
-// Remove a sprite from the sprite system. Note that this function is not currently
-// used. The typical case is that sprites automatically get removed when the reach
-// their lifespan.
-//
-void SpriteSystem::remove(int i) {
-	sprites.erase(sprites.begin() + i);
-}
-
-// set the collision sound loaded to true and load the collision sound
-void SpriteSystem::setBoom(ofSoundPlayer theBoom) {
-	hasBoom = true;
-	boomSound = theBoom;
-}
-
-// remove sprites at a given distance from point
-// return number removed
-int SpriteSystem::removeNear(glm::vec3 point, float dist) {
-	vector<Sprite>::iterator s = sprites.begin();
-	vector<Sprite>::iterator tmp;
-	int count = 0;
-
-	while (s != sprites.end()) {
-		glm::vec3 v = s->trans - point;
-		if (glm::length(v) < dist) {
-			tmp = sprites.erase(s);
-			if (hasBoom) boomSound.play();
-			count++;
-			s = tmp;
-		} else {
-			s++;
-		}
-	}
-	return count;
-}
-
-//  Update the SpriteSystem by checking which sprites have exceeded their
-//  lifespan (and deleting).  Also the sprite is moved to it's next
-//  location based on velocity and direction.
-//
-void SpriteSystem::update() {
-
-	if (sprites.size() == 0) return;
-	vector<Sprite>::iterator s = sprites.begin();
-	vector<Sprite>::iterator tmp;
-
-	// check which sprites have exceed their lifespan and delete
-	// from list.  When deleting multiple objects from a vector while
-	// traversing at the same time, use an iterator.
-	//
-	while (s != sprites.end()) {
-		if (s->lifespan != -1 && s->age() > s->lifespan) {
-			//			cout << "deleting sprite: " << s->name << endl;
-			tmp = sprites.erase(s);
-			s = tmp;
-		}
-		else s++;
-	}
-
-	//  Move sprite
-	//
-	for (int i = 0; i < sprites.size(); i++) {
-		sprites[i].trans += sprites[i].velocity / ofGetFrameRate();
-	}
-}
-
-//  Render all the sprites
-//
-void SpriteSystem::draw() {
-	for (int i = 0; i < sprites.size(); i++) {
-		sprites[i].draw();
-	}
-}
-
-//  Create a new Emitter - needs a SpriteSystem
-//
-Emitter::Emitter(SpriteSystem *spriteSys) {
-	sys = spriteSys;
-	lifespan = LIFE;    // milliseconds
-	started = false;
-
-	lastSpawned = 0;
-	rate = 1;    // sprites/sec
-	haveChildImage = false;
-	haveImage = false;
-	firingDir = 0;
-	// store the matrix to use for rotating firing direction
-	// multiplied to velocity
-	rotDir = glm::rotate(glm::mat4(1.0), glm::radians(firingDir), glm::vec3(0, 0, 1));
-	velocity = glm::vec4(glm::vec3(0, FIRING_SPEED, 1), 1);
-	// set initial turret travel direction matrix using initial rotation amount
-	emitterRot = glm::rotate(glm::mat4(1.0), glm::radians(rot), glm::vec3(0, 0, 1));
-	drawable = true;
-	width = 50;
-	height = 50;
-	childWidth = 60;
-	childHeight = 80;
-	bSelected = false;
-	playFireSound = false;
-	hasSound = false;
-
-	// initialize integrator vectors and values
-	moveVelocity = glm::vec3(0, 0, 0);
-	moveAcceleration = glm::vec3(0, 0, 0);
-	moveForces = glm::vec3(0, 0, 0);
-	moveRotVel = 0.0;
-	moveRotAcc = 0.0;
-	moveRotForces = 0.0;
-	moveDamping = 0.99;
-}
-
-//  Draw the Emitter if it is drawable. In many cases you would want a hidden emitter
-//
-//
-void Emitter::draw() {
-	// draw sprite system
-	//
-	sys->draw();
-
-	if (drawable) {
-
-		if (haveImage) {
-			// make sure image of emitter can be tranformed with use of
-			// matrix manipulation
-			ofPushMatrix();
-			ofMultMatrix(getMatrix());
-			image.draw(-image.getWidth() / 2.0, -image.getHeight() / 2.0);
-			ofPopMatrix();
-		}
-		else {
-			ofSetColor(0, 0, 200);
-			ofPushMatrix();
-			ofMultMatrix(getMatrix());
-			ofDrawRectangle(-width / 2, -height / 2, width, height);
-			ofPopMatrix();
-		}
-	}
-}
-
-//  Update the Emitter. If it has been started, spawn new sprites with
-//  initial velocity, lifespan, birthtime.
-//
-void Emitter::update() {
-	if (!started) return;
-
-	float time = ofGetElapsedTimeMillis();
-	if ((time - lastSpawned) > (1000.0 / rate)) {
-		// spawn a new sprite
-		Sprite sprite;
-		if (haveChildImage) sprite.setImage(childImage);
-		// velocity keeps its original rate but is rotated by matrix
-		sprite.velocity = rotDir * glm::vec4(velocity, 1);
-		sprite.lifespan = lifespan;
-		sprite.setPosition(trans);
-		sprite.birthtime = time;
-		sys->add(sprite);
-		// utilizes established emitter update rate
-		// to check if sound should be played when firing
-		if (hasSound && playFireSound) fireSound.play();
-		lastSpawned = time;
-	}
-	sys->update();
-}
-
-// Start/Stop the emitter.
-//
-void Emitter::start() {
-	started = true;
-	lastSpawned = ofGetElapsedTimeMillis();
-}
-
-void Emitter::stop() {
-	started = false;
-}
-
-
-void Emitter::setLifespan(float life) {
-	lifespan = life;
-}
-
-void Emitter::setVelocity(glm::vec3 v) {
-	velocity = v;
-}
-
-void Emitter::setChildImage(ofImage img) {
-	childImage = img;
-	haveChildImage = true;
-}
-
-void Emitter::setImage(ofImage img) {
-	image = img;
-	haveImage = true;
-	width = image.getWidth();
-	height = image.getHeight();
-}
-
-void Emitter::setRate(float r) {
-	rate = r;
-}
-
-
-// update the degree of rotation for firing direction
-// and apply changes to the matrix
-void Emitter::setFiringDir(float deg) {
-	firingDir = deg;
-}
-
-void Emitter::setFiringMat(float deg) {
-	rotDir = glm::rotate(glm::mat4(1.0), glm::radians(deg), glm::vec3(0, 0, 1));
-}
-
-// set the matrix that will be multiplied into the heading of travel 
-// for turret when key pressed
-void Emitter::setEmitterMat(float deg) {
-	emitterRot = glm::rotate(glm::mat4(1.0), glm::radians(deg), glm::vec3(0, 0, 1));
-}
-
-// set firing sound
-void Emitter::setFireSound(ofSoundPlayer sound) {
-	hasSound = true;
-	fireSound = sound;
-}
-
-// integrator for moving an emitter
-void Emitter::integrate() {
-	// linear thrust
-	float dt = 1.0 / ofGetFrameRate();
-	trans = trans + (moveVelocity * dt);
-	glm::vec3 accel = moveAcceleration;
-	accel = accel + moveForces;
-	moveVelocity = moveVelocity + (accel * dt);
-	moveVelocity = moveVelocity * moveDamping;
-
-	// angular thrust
-	rot = rot + (moveRotVel * dt);
-	float rotAcceler = moveRotAcc;
-	rotAcceler = rotAcceler + moveRotForces;
-	moveRotVel = moveRotVel + (rotAcceler * dt);
-	moveRotVel = moveRotVel * moveDamping;
-
-	// adjust rotational matrix accordingly to guide turret travel heading
-	setEmitterMat(rot);
-	// adjust firing direction
-	setFiringDir(rot);
-	setFiringMat(rot);
-
-	// reset forces after each integraion
-	moveRotForces = 0.0;
-	moveForces = glm::vec3(0, 0, 0);
-}
-
-//--------------------------------------------------------------
-Particle::Particle(glm::vec3 dot) {
-	this->setPosition(dot);
-	debrisVel = glm::vec3(0, 0, 0);
-	debrisAccel = glm::vec3(0, 0, 0);
-	debrisForces = glm::vec3(0, 0, 0);
-	debrisDamping = 0.99;
-}
-
-void Particle::draw() {
-	ofSetColor(255, 0, 0);
-	ofDrawRectangle(-5 + trans.x, -5 + trans.y, 5, 5);
-}
-
-void Particle::integrate() {
-	float dt = 1.0 / ofGetFrameRate();
-	trans = trans + (debrisVel * dt);
-	glm::vec3 accel = debrisAccel;
-	accel = accel + debrisForces;
-	debrisVel = debrisVel + (accel * dt);
-	debrisVel *= debrisDamping;
-	debrisForces = glm::vec3(0, 0, 0);
-}
-
-Explosion::Explosion(glm::vec3 boomSite, int pts, float life, float power, int dust) {
-	this->setPosition(boomSite);
-	this->lifespan = life * 1000;// 1500;
-	this->birthtime = ofGetElapsedTimeMillis();
-	this->debrisCount = dust;// 20;
-	this->points = pts;
-	float addRot = 0.0;
-	// set up each particle that is part of explosion
-	for (int i = 0; i < debrisCount; i++) {
-		Particle aDebris(boomSite);
-		glm::mat4 debRotMat =
-			glm::rotate(glm::mat4(1.0), glm::radians(addRot), glm::vec3(0, 0, 1));
-		aDebris.debrisForces =
-			debRotMat * glm::vec4(0, power * 1000, 0, 0);//15000, 0, 0);
-		particles.push_back(aDebris);
-		addRot += (360.0 / debrisCount);
-	}
-}
-
-void Explosion::update() {
-	for (Particle& p : particles) {
-		p.integrate();
-	}
-}
-
-void Explosion::draw() {
-	ofSetColor(255, 0, 0);
-	for (Particle& p : particles) {
-		p.draw();
-	}
-	//ofDrawRectangle(-15 + trans.x, -15 + trans.y, 15, 15);
-	string boomPts = "+" + std::to_string(points);
-	ofDrawBitmapString(boomPts, ofPoint(trans.x, trans.y));
-}
-
-float Explosion::age() {
-	return ofGetElapsedTimeMillis() - birthtime;
-}
-
-// helper method to add explosion to perform
-void ofApp::addBoom(glm::vec3 boomPos, int thePts) {
-	Explosion newBoom(boomPos, thePts, (float)boomLife, (float)boomPower, (int)boomDust);
-	booms.push_back(newBoom);
-}
-
-// helper method to be put in update to remove expired booms
-void ofApp::removeBoom() {
-	if (booms.size() == 0) return;
-	vector<Explosion>::iterator b = booms.begin();
-	vector<Explosion>::iterator tmp;
-
-	while (b != booms.end()) {
-		if (b->lifespan != -1 && b->age() > b->lifespan) {
-			tmp = booms.erase(b);
-			b = tmp;
-		}
-		else b++;
-	}
-}
+// waves past this many keep the lifespan from their definition
+#define MAX_LIFESPAN_SLIDERS 8
 
 //--------------------------------------------------------------
 void ofApp::setup(){
-	ofSetVerticalSync(true);
-
-	// load background image
-	if (bkgImg.load("images/Project1_bkg.png")) {
-		validBkg = true;
-	}
-
-	score = 0;
-
-	// create an image for sprites being spawned by emitter
-	//
-	if (defaultImage.load("images/Project1_projectile.png")) {
-		imageLoaded = true;
-	} else {
-		/*ofLogFatalError("can't load image: images/Project1_projectile.png");
-		ofExit();*/
-		imageLoaded = false;
-	}
-	// create image for invaders
-	if (invaderImage.load("images/P1_enemy.png")) {
-		invaderLoaded = true;
-	} else {
-		invaderLoaded = false;
-	}
-	if (specInvImage.load("images/P1_whitehot.png")) {
-		specInvLoaded = true;
-	} else {
-		specInvLoaded = false;
-	}
-
-	projectiles = new Emitter(new SpriteSystem());
-	projectiles->setPosition(glm::vec3(ofGetWindowWidth() / 2.0, ofGetWindowHeight() / 2.0, 1));
-	projectiles->drawable = true;                // make emitter itself visible
-	// set turret image, will be parent image for emitter
-	if (turretImage.load("images/Project1_ship.png")) {
-		projectiles->setImage(turretImage);
-	} /*else {
-		ofLogFatalError("can't load image: images/Project1_ship.png");
-		ofExit();
-	}*/
-	if (imageLoaded) {
-		projectiles->setChildImage(defaultImage);
-		projectiles->setChildSize(defaultImage.getWidth(), defaultImage.getHeight());
-	}
-
-	// load the sound and set marker that sound loaded to true if successful
-	if (firingSound.load("sounds/Project1_fireSound.wav")) {
-		soundLoaded = true;
-		projectiles->setFireSound(firingSound);
-	}
-
-	projectiles->setRate(0.001);
-
-	projectiles->stop(); // game initially is in idle state
-
-	// load collision sound
-	if (invaderBoom.load("sounds/P1_collSound.wav")) {
-		invBoomLoaded = true;
+	// the stress test runs as fast as it can to find the real frame time
+	ofSetVerticalSync(!scenario.enabled);
+	if (scenario.enabled) ofSetFrameRate(0);
+
+	// start decoding every image, the fonts below are all the start
+	// screen needs so it can show while the images are still loading
+	loader.setup();
+	bkgImg = loader.loadImage(images, "images/Project1_bkg.png");
+	defaultImage = loader.loadImage(images, "images/Project1_projectile.png");
+	turretImage = loader.loadImage(images, "images/Project1_ship.png");
+
+	// create the ship and invader emitters, the invader waves come from
+	// data/emitters.json or else are the built in ones
+	vector<EmitterDef> waves = EmitterGroup::getDefaults();
+	if (!loadEmitterDefs("emitters.json", waves)) {
+		ofLogWarning("ofApp") << "using the built in invader waves";
+	}
+	game.setup(ofGetWindowWidth(), ofGetWindowHeight(), scenario.enabled ? scenario.seed : (uint32_t)time(nullptr), waves);
+	if (scenario.enabled) scenario.setup(game);
+	for (const EmitterDef &def : game.invaders.defs) {
+		waveImages.push_back(def.image.empty() ? NO_IMAGE : loader.loadImage(images, def.image));
+		if (waveNames.size() < MAX_PROFILED_WAVES) waveNames.push_back(def.name);
 	}
 
-	// set up first set of invaders (comes from top)
-	invaders1 = new Emitter(new SpriteSystem());
-	invaders1->setPosition(glm::vec3(ofGetWindowWidth() / 2.0, 0.0, 1));
-	invaders1->drawable = false;
-	if (invaderLoaded) {
-		invaders1->setChildImage(invaderImage);
-		invaders1->setChildSize(invaderImage.getWidth(), invaderImage.getHeight());
-	}
-	invaders1->setRate(0.5);
-	invaders1->setVelocity(glm::vec3(0, 400, 1));
-	if (invBoomLoaded) invaders1->sys->setBoom(invaderBoom);
-	invaders1->stop();
-
-	// set up second set of invaders (comes from left)
-	invaders2 = new Emitter(new SpriteSystem());
-	invaders2->setPosition(glm::vec3(0.0, ofGetWindowHeight() / 2.0, 1));
-	invaders2->drawable = false;
-	if (invaderLoaded) {
-		invaders2->setChildImage(invaderImage);
-		invaders2->setChildSize(invaderImage.getWidth(), invaderImage.getHeight());
-	}
-	invaders2->setRate(0.5);
-	invaders2->setVelocity(glm::vec3(400, 0, 1));
-	if (invBoomLoaded) invaders2->sys->setBoom(invaderBoom);
-	invaders2->stop();
-
-	// set up for third set of invaders (comes from right)
-	invaders3 = new Emitter(new SpriteSystem());
-	invaders3->setPosition(glm::vec3(ofGetWindowWidth(), ofGetWindowHeight() / 2.0, 1));
-	invaders3->drawable = false;
-	if (invaderLoaded) {
-		invaders3->setChildImage(invaderImage);
-		invaders3->setChildSize(invaderImage.getWidth(), invaderImage.getHeight());
-	}
-	invaders3->setRate(0.5);
-	invaders3->setVelocity(glm::vec3(-400, 0, 1));
-	if (invBoomLoaded) invaders3->sys->setBoom(invaderBoom);
-	invaders3->stop();
-
-	// set up for fourth set of invaders (comes from bottom)
-	invaders4 = new Emitter(new SpriteSystem());
-	invaders4->setPosition(glm::vec3(ofGetWindowWidth() / 2.0, ofGetWindowHeight(), 1));
-	invaders4->drawable = false;
-	if (invaderLoaded) {
-		invaders4->setChildImage(invaderImage);
-		invaders4->setChildSize(invaderImage.getWidth(), invaderImage.getHeight());
-	}
-	invaders4->setRate(0.5);
-	invaders4->setVelocity(glm::vec3(0, -400, 1));
-	if (invBoomLoaded) invaders4->sys->setBoom(invaderBoom);
-	invaders4->stop();
-
-	// set up for special invader (comes from corner)
-	invaderS = new Emitter(new SpriteSystem());
-	invaderS->setPosition(glm::vec3(0, 0, 1));
-	invaderS->drawable = false;
-	if (specInvLoaded) {
-		invaderS->setChildImage(specInvImage);
-		invaderS->setChildSize(specInvImage.getWidth(), specInvImage.getHeight());
-	}
-	invaderS->setRate(0.2);
-	invaderS->setVelocity(glm::vec3(1500, 1500, 1));
-	if (invBoomLoaded) invaderS->sys->setBoom(invaderBoom);
-	invaderS->stop();
-
 	// set up sliders
 	gui.setup();
 	//gui.add(rate.setup("Rate (turret)", 20, 1, 30)); // adjusts rate of fire
 	//gui.add(fDir.setup("firing direction", 0, -360, 360)); // adjusts firing direction
-	gui.add(lifespan1.setup("Lifespan (top)", 4, 0, 5));
-	gui.add(lifespan2.setup("Lifespan (left)", 4, 0, 5));
-	gui.add(lifespan3.setup("Lifespan (right)", 4, 0, 5));
-	gui.add(lifespan4.setup("Lifespan (bottom)", 4, 0, 5));
-	gui.add(lifespanS.setup("Lifespan (sp)", 4, 0, 5));
+	for (int i = 0; i < min(game.invaders.size(), MAX_LIFESPAN_SLIDERS); i++) {
+		const EmitterDef &def = game.invaders.defs[i];
+		lifespans.emplace_back();
+		gui.add(lifespans.back().setup("Lifespan (" + def.name + ")", def.lifespan, 0, 5));
+	}
 	gui.add(shipThrust.setup("Ship Thrust", 2000, 1000, 5000));
 	//gui.add(rate1.setup("Rate (top)", 0.5, 0.5, 5));
 	//gui.add(rate2.setup("Rate (left)", 0.5, 0.5, 5));
@@ -561,238 +58,236 @@ void ofApp::setup(){
 	
 	bHide = true;
 
+	uint64_t start = ofGetElapsedTimeMicros();
 	scoreBoard.load("fonts/verdana.ttf", 24);
 	gameStartText.load("fonts/verdana.ttf", 18);
-}
+	labelFont.load("fonts/verdana.ttf", 10);
+	loader.addTime("fonts/verdana.ttf (3 sizes)", (ofGetElapsedTimeMicros() - start) / 1000.0);
 
-//--------------------------------------------------------------
-void ofApp::update(){
-	// update projectiles emitter to register
-	// changes from sliders
-	//projectiles->setRate(rate);
-	//projectiles->setFiringDir(fDir);
-	//projectiles->setFiringMat(fDir);
-
-	// allows for ship to wrap around screen if goes out of bounds
-	if (projectiles->trans.x < 0) {
-		projectiles->setPosition(glm::vec3(ofGetWindowWidth() - 1, projectiles->trans.y, 1));
-	}
-	if (projectiles->trans.x > ofGetWindowWidth()) {
-		projectiles->setPosition(glm::vec3(1, projectiles->trans.y, 1));
+	// lay out the text once, the score is redone only when it changes
+	scoreText.setup(&scoreBoard, "Score: ");
+	startText.setup(&gameStartText);
+	startText.setText("Loading...");
+	// one label for each points value a wave can give
+	boomLabels.setup(&labelFont);
+	for (const EmitterDef &def : game.invaders.defs) {
+		boomLabels.bake(def.points, "+" + ofToString(def.points));
 	}
-	if (projectiles->trans.y < 0) {
-		projectiles->setPosition(glm::vec3(projectiles->trans.x, ofGetWindowHeight() - 1, 1));
+}
+
+//  Called once every image has been uploaded: give the ship and
+//  invaders their images, pack the atlas and load the sounds, after
+//  which the game can start
+//
+void ofApp::finishLoading() {
+	// set turret image, will be parent image for emitter
+	if (images.isValid(turretImage)) {
+		game.projectiles->setImage(turretImage, images.getWidth(turretImage), images.getHeight(turretImage));
 	}
-	if (projectiles->trans.y > ofGetWindowHeight()) {
-		projectiles->setPosition(glm::vec3(projectiles->trans.x, 1, 1));
+	// create an image for sprites being spawned by emitter
+	if (images.isValid(defaultImage)) {
+		game.projectiles->setChildImage(defaultImage);
+		game.projectiles->setChildSize(images.getWidth(defaultImage), images.getHeight(defaultImage));
+	}
+
+	// the image of every invader wave, waves sharing an image share one
+	// copy of it
+	vector<ImageHandle> atlasImages = { defaultImage, turretImage };
+	for (int i = 0; i < waveImages.size(); i++) {
+		ImageHandle img = waveImages[i];
+		if (!images.isValid(img)) continue;
+		Emitter *e = game.invaders.emitters[i];
+		e->setChildImage(img);
+		e->setChildSize(images.getWidth(img), images.getHeight(img));
+		if (find(atlasImages.begin(), atlasImages.end(), img) == atlasImages.end()) {
+			atlasImages.push_back(img);
+		}
 	}
 
-	if (projectiles->started) projectiles->integrate();
-	projectiles->update();
-
-	// updates first set of invaders
-	// can launch from most of the top section of screen
-	int inv1PosX = (int)ofRandom(ofGetWindowWidth() * 0.05, 0.95 * ofGetWindowWidth());
-	invaders1->setPosition(glm::vec3(inv1PosX, 0.0, 1));
-	// velocity increases with score increase, random within a range
-	int inv1VelY = (int)ofRandom(400, 601);
-	invaders1->setVelocity(glm::vec3(0, inv1VelY + (0.75 * score), 1));
-	// random direction within a range to provide some fun
-	int inv1Dir = (int)ofRandom(-45, 46);
-	invaders1->setFiringDir((float)inv1Dir);
-	invaders1->setFiringMat((float)inv1Dir);
-	// random rate within a range, increases with score 
-	float inv1Rate = ofRandom(0.25, 0.51);
-	invaders1->setRate(inv1Rate + (score / 500.0));
-	// set lifespan to slider amount
-	invaders1->setLifespan(lifespan1 * 1000);
-	// set rate to slider amount
-	//invaders1->setRate(rate1);
-	invaders1->update();
-
-	// updates second set of invaders
-	// can launch from most of the left section of screen
-	int inv2PosY = (int)ofRandom(ofGetWindowHeight() * 0.05, 0.95 * ofGetWindowHeight());
-	invaders2->setPosition(glm::vec3(0.0, inv2PosY, 1));
-	// velocity increases with score increase, random within a range
-	int inv2VelX = (int)ofRandom(400, 601);
-	invaders2->setVelocity(glm::vec3(inv2VelX + (0.75 * score), 0, 1));
-	// random direction within a range to provide some fun
-	int inv2Dir = (int)ofRandom(-45, 46);
-	invaders2->setFiringDir((float)inv2Dir);
-	invaders2->setFiringMat((float)inv2Dir);
-	// random rate within a range, increases with score
-	float inv2Rate = ofRandom(0.25, 0.51);
-	invaders2->setRate(inv2Rate + (score / 500.0));
-	// set lifespan to slider amount
-	invaders2->setLifespan(lifespan2 * 1000);
-	// set rate to slider amount
-	//invaders2->setRate(rate2);
-	invaders2->update();
-
-	// update third set of invaders
-	// can launch from most of right section of screen
-	int inv3PosY = (int)ofRandom(ofGetWindowHeight() * 0.05, 0.95 * ofGetWindowHeight());
-	invaders3->setPosition(glm::vec3(ofGetWindowWidth(), inv3PosY, 1));
-	// velocity increases with score increase, random within a range
-	int inv3VelX = (int)ofRandom(-600, -399);
-	invaders3->setVelocity(glm::vec3(inv3VelX - (0.75 * score), 0, 1));
-	// random direction within a range to provide some fun
-	int inv3Dir = (int)ofRandom(-45, 46);
-	invaders3->setFiringDir((float)inv3Dir);
-	invaders3->setFiringMat((float)inv3Dir);
-	// random rate within a range, increases with score
-	float inv3Rate = ofRandom(0.25, 0.51);
-	invaders3->setRate(inv3Rate + (score / 500.0));
-	// set lifespan to slider amount
-	invaders3->setLifespan(lifespan3 * 1000);
-	// set rate to slider amount
-	//invaders3->setRate(rate3);
-	invaders3->update();
-
-	// update fourth set of invaders
-	// can launch from most of bottom section of screen
-	int inv4PosX = (int)ofRandom(ofGetWindowWidth() * 0.05, 0.95 * ofGetWindowWidth());
-	invaders4->setPosition(glm::vec3(inv4PosX, ofGetWindowHeight(), 1));
-	// velocity increases with score increase, random within a range
-	int inv4VelY = (int)ofRandom(-600, -399);
-	invaders4->setVelocity(glm::vec3(0, inv4VelY - (0.75 * score), 1));
-	// random direction within a range to provide some fun
-	int inv4Dir = (int)ofRandom(-45, 46);
-	invaders4->setFiringDir((float)inv4Dir);
-	invaders4->setFiringMat((float)inv4Dir);
-	// random rate within a range, increases with score
-	float inv4Rate = ofRandom(0.25, 0.51);
-	invaders4->setRate(inv4Rate + (score / 500.0));
-	// set lifespan to slider amount
-	invaders4->setLifespan(lifespan4 * 1000);
-	// set rate to slider amount
-	//invaders4->setRate(rate4);
-	invaders4->update();
-
-	// update for special invader
-	// can launch from any of the four corners, chosen randomly
-	int invSPosStart = (int)ofRandom(0, 4);
-	switch (invSPosStart) {
-	case 0:
-		invaderS->setPosition(glm::vec3(0, 0, 1));
-		invaderS->setVelocity(glm::vec3(1500 + (score * 0.75), 1500 + (score * 0.75), 1));
-		break;
-	case 1:
-		invaderS->setPosition(glm::vec3(ofGetWindowWidth(), 0, 1));
-		invaderS->setVelocity(glm::vec3(-1500 - (score * 0.75), 1500 + (score * 0.75), 1));
-		break;
-	case 2:
-		invaderS->setPosition(glm::vec3(0, ofGetWindowHeight(), 1));
-		invaderS->setVelocity(glm::vec3(1500 + (score * 0.75), -1500 - (score * 0.75), 1));
-		break;
-	case 3:
-		invaderS->setPosition(glm::vec3(ofGetWindowWidth(), ofGetWindowHeight(), 1));
-		invaderS->setVelocity(glm::vec3(-1500 - (score * 0.75), -1500 - (score * 0.75), 1));
-		break;
-	default:
-		break;
-	}
-	// random direction within a range to provide more fun
-	int invSDir = (int)ofRandom(-45, 46);
-	invaderS->setFiringDir(invSDir);
-	invaderS->setFiringMat(invSDir);
-	// random rate within a range to keep player guessing
-	float invSRate = ofRandom(0.14, 0.21);
-	invaderS->setRate(invSRate);
-	// set lifespan to slider amount
-	invaderS->setLifespan(lifespanS * 1000);
-	// set rate to slider amount
-	//invaderS->setRate(rateS);
-	invaderS->update();
-
-	// check collisions between projectiles and invaders
-	checkCollisions();
-	// only update explosions if game starts
-	if (gameStarted) {
-		for (Explosion& e : booms) {
-			e.update();
+	// pack the sprite images into one texture so they can be batched
+	uint64_t start = ofGetElapsedTimeMicros();
+	spriteBatch.buildAtlas(images, atlasImages);
+	loader.addTime("sprite atlas", (ofGetElapsedTimeMicros() - start) / 1000.0);
+
+	// load the firing and collision sounds, a sound that fails to load
+	// is just never played
+	start = ofGetElapsedTimeMicros();
+	audio.setup();
+	firingSound = audio.load("sounds/Project1_fireSound.wav");
+	invaderBoom = audio.load("sounds/P1_collSound.wav");
+	loader.addTime("sounds", (ofGetElapsedTimeMicros() - start) / 1000.0);
+
+	startText.setText("Press space to start the game");
+	assetsReady = true;
+	sim.start();
+	loader.logTimes();
+	ofLogNotice("ofApp") << "assets ready after " << ofGetElapsedTimeMillis() << " ms";
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+	Profiler::get().beginFrame();
+	PROFILE_SCOPE(StageUpdate);
+
+	// upload the images decoded since the last frame
+	if (!assetsReady) {
+		loader.update(images);
+		validBkg = images.isValid(bkgImg);
+		if (loader.isDone()) finishLoading();
+	}
+
+	// hand the slider values and window size to the simulation
+	vector<float> lives(lifespans.begin(), lifespans.end());
+	float thrust = shipThrust;
+	float power = boomPower;
+	float life = boomLife;
+	int dust = boomDust;
+	float w = ofGetWindowWidth();
+	float h = ofGetWindowHeight();
+	sim.post([=](Game &game) {
+		for (int i = 0; i < lives.size(); i++) {
+			game.invaders.defs[i].lifespan = lives[i];
 		}
+		game.settings.shipThrust = thrust;
+		game.settings.boomPower = power;
+		game.settings.boomLife = life;
+		game.settings.boomDust = dust;
+		game.setWorldSize(w, h);
+	});
+
+	// the stress test holds fire as soon as the game can start
+	if (scenario.enabled && assetsReady) scenario.drive(sim);
+
+	// the simulation thread runs the ticks, this frame draws the newest
+	// state it has published
+	snapshot = sim.acquire();
+
+	if (scenario.enabled && snapshot && scenario.record(*snapshot, ofGetLastFrameTime())) {
+		scenario.writeResults();
+		ofExit();
 	}
-	removeBoom();
+
+	// play the sounds the simulation asked for, each sound at most
+	// once per frame
+	SoundEvents sounds = sim.takeSounds();
+	audio.trigger(firingSound, sounds.fire);
+	audio.trigger(invaderBoom, sounds.boom);
+	audio.flush();
 }
 
 //--------------------------------------------------------------
 void ofApp::draw(){
-	if (validBkg) bkgImg.draw(0, 0); // draw background if valid
-	projectiles->draw();
-	invaders1->draw();
-	invaders2->draw();
-	invaders3->draw();
-	invaders4->draw();
-	invaderS->draw();
-
-	// draw explosions here
-	for (Explosion& e : booms) {
-		e.draw();
-	}
-	ofSetColor(255, 255, 255, 255);
+	{
+		PROFILE_SCOPE(StageDraw);
+
+		if (validBkg) images.get(bkgImg).draw(0, 0); // draw background if valid
+
+		// draw the snapshot part way from the tick before it, by how
+		// far real time has got into the next tick
+		float alpha = snapshot ? snapshot->getAlpha(std::chrono::steady_clock::now()) : 1;
+		float lag = snapshot ? snapshot->getLag(alpha) : 0;
+
+		// gather every sprite system and the ship into one draw call
+		if (assetsReady && snapshot) {
+			PROFILE_SCOPE(StageDrawSprites);
+			spriteBatch.setView(ofGetWindowWidth(), ofGetWindowHeight());
+			spriteBatch.begin();
+			for (int i = 0; i < snapshot->systems.size(); i++) {
+				spriteBatch.addSprites(snapshot->systems[i], lag);
+				// the ship goes over its own projectiles
+				if (i == 0) spriteBatch.addShip(snapshot->ship, alpha);
+			}
+			spriteBatch.draw();
+		}
+
+		// draw explosions here
+		if (snapshot) {
+			PROFILE_SCOPE(StageDrawExplosions);
+			debris.update(*snapshot, lag);
+			debris.draw();
+			ofSetColor(255, 0, 0);
+			boomLabels.begin();
+			for (const Explosion &e : snapshot->booms) {
+				boomLabels.add(e.points, e.trans.x, e.trans.y);
+			}
+			boomLabels.draw();
+		}
+		ofSetColor(255, 255, 255, 255);
 
-	// draw score
-	string scoreText;
-	scoreText += "Score: " + std::to_string(score);
-	scoreBoard.drawString(scoreText, ofGetWindowWidth() / 2.0 - 80, 40);
+		// draw score
+		{
+			PROFILE_SCOPE(StageDrawText);
+			scoreText.setNumber(snapshot ? snapshot->score : 0);
+			scoreText.draw(ofGetWindowWidth() / 2.0 - 80, 40);
 
-	if (!gameStarted) {
-		gameStartText.drawString("Press space to start the game", ofGetWindowWidth() / 2.0 - 200, ofGetWindowHeight() - 100);
+			if (!snapshot || !snapshot->gameStarted) {
+				startText.draw(ofGetWindowWidth() / 2.0 - 200, ofGetWindowHeight() - 100);
+			}
+		}
+
+		if (!bHide) {
+			gui.draw();
+		}
 	}
 
-	if (!bHide) {
-		gui.draw();
+	if (showProfiler) drawProfiler();
+	Profiler::get().endFrame();
+
+	if (!firstFrameDrawn) {
+		firstFrameDrawn = true;
+		ofLogNotice("ofApp") << "first frame after " << ofGetElapsedTimeMillis() << " ms";
 	}
 }
 
-// collision checking
-void ofApp::checkCollisions() {
-	// distances where projectile should count as collided with invader
-	float collisionDist1 = projectiles->childHeight / 2 + invaders1->childHeight / 2;
-	float collisionDist2 = projectiles->childHeight / 2 + invaders2->childHeight / 2;
-	float collisionDist3 = projectiles->childHeight / 2 + invaders3->childHeight / 2;
-	float collisionDist4 = projectiles->childHeight / 2 + invaders4->childHeight / 2;
-	float collisionDistS = projectiles->childHeight / 2 + invaderS->childHeight / 2;
-
-	// loop through projectiles, remove hit invaders
-	for (int i = 0; i < projectiles->sys->sprites.size(); i++) {
-		int oldScore = score;
-		// regular invaders worth 1 point
-		score += invaders1->sys->removeNear(projectiles->sys->sprites[i].trans, collisionDist1);
-		// check for explosion here
-		if (score > oldScore) {
-			addBoom(projectiles->sys->sprites[i].trans, 1);
-			oldScore = score;
-		}
-		score += invaders2->sys->removeNear(projectiles->sys->sprites[i].trans, collisionDist2);
-		// check for explosion here
-		if (score > oldScore) {
-			addBoom(projectiles->sys->sprites[i].trans, 1);
-			oldScore = score;
-		}
-		score += invaders3->sys->removeNear(projectiles->sys->sprites[i].trans, collisionDist3);
-		// check for explosion here
-		if (score > oldScore) {
-			addBoom(projectiles->sys->sprites[i].trans, 1);
-			oldScore = score;
-		}
-		score += invaders4->sys->removeNear(projectiles->sys->sprites[i].trans, collisionDist4);
-		// check for explosion here
-		if (score > oldScore) {
-			addBoom(projectiles->sys->sprites[i].trans, 1);
-			oldScore = score;
-		}
+// draw p50/p95/p99 of every timed stage over the recorded frames, or
+// ticks for the simulation stages, and the entity counts of the last
+// tick, per invader wave too, and how many sprites this frame drew
+// as quads and culled, to the right of the gui panel
+void ofApp::drawProfiler() {
+	Profiler &profiler = Profiler::get();
+	float x = gui.getPosition().x + gui.getWidth() + 20;
+	float y = gui.getPosition().y + 20;
 
-		// special invader worth 4 points
-		score += invaderS->sys->removeNear(projectiles->sys->sprites[i].trans, collisionDistS) * 4;
-		// check for explosion here
-		if (score > oldScore) {
-			addBoom(projectiles->sys->sprites[i].trans, 4);
-			oldScore = score;
+	ofSetColor(0, 0, 0, 180);
+	ofDrawRectangle(x - 10, y - 20, 360, (StageCount + CounterCount + waveNames.size() + 7) * 15 + 20);
+	ofSetColor(255, 255, 255, 255);
+
+	// the frame stages, then the tick stages
+	for (int ticks = 0; ticks < 2; ticks++) {
+		ofDrawBitmapString(ticks ? "tick (ms)           p50     p95     p99" : "frame (ms)          p50     p95     p99", x, y);
+		for (int s = 0; s < StageCount; s++) {
+			ProfileStage stage = (ProfileStage)s;
+			if (Profiler::isTickStage(stage) != (ticks == 1)) continue;
+			char line[80];
+			snprintf(line, sizeof(line), "%-16s %7.3f %7.3f %7.3f", Profiler::getStageName(stage),
+				profiler.getPercentile(stage, 50), profiler.getPercentile(stage, 95), profiler.getPercentile(stage, 99));
+			y += 15;
+			ofDrawBitmapString(line, x, y);
+		}
+		y += 30;
+	}
+	ofDrawBitmapString("sprites", x, y);
+	for (int c = 0; c < CounterCount; c++) {
+		ProfileCounter counter = (ProfileCounter)c;
+		char line[80];
+		snprintf(line, sizeof(line), "%-16s %7d", Profiler::getCounterName(counter), profiler.getLastCount(counter));
+		y += 15;
+		ofDrawBitmapString(line, x, y);
+		if (counter != CountInvaders) continue;
+		for (int w = 0; w < waveNames.size(); w++) {
+			snprintf(line, sizeof(line), "  %-14.14s %7d", waveNames[w].c_str(), profiler.getLastWaveCount(w));
+			y += 15;
+			ofDrawBitmapString(line, x, y);
 		}
 	}
+	// off screen sprites are skipped when the batch is built
+	char line[80];
+	snprintf(line, sizeof(line), "%-16s %7d", "quads", spriteBatch.getQuadCount());
+	y += 15;
+	ofDrawBitmapString(line, x, y);
+	snprintf(line, sizeof(line), "%-16s %7d", "culled", spriteBatch.getCulledCount());
+	y += 15;
+	ofDrawBitmapString(line, x, y);
 }
 
 //--------------------------------------------------------------
@@ -807,28 +302,24 @@ void ofApp::keyPressed(int key){
 		// toggle visibility of sliders
 		bHide = !bHide;
 		break;
+	case 'P':
+	case 'p':
+		// toggle frame timing overlay
+		showProfiler = !showProfiler;
+		break;
+	case 'D':
+	case 'd':
+		// dump the recorded frame and tick times
+		{
+			string path = ofToDataPath("profile_" + ofGetTimestampString() + ".csv", true);
+			if (Profiler::get().writeCsv(path)) ofLogNotice() << "wrote frame and tick times to " << path;
+			else ofLogError() << "can't write " << path;
+		}
+		break;
 	case ' ':
 		//cout << "space pressed" << endl;
-		if (!gameStarted) gameStarted = true;
-		// space starts the game by starting all emitters
-		if (!projectiles->started) projectiles->start(); 
-		if (!invaders1->started) invaders1->start();
-		if (!invaders2->started) invaders2->start();
-		if (!invaders3->started) invaders3->start();
-		if (!invaders4->started) invaders4->start();
-		if (!invaderS->started) invaderS->start();
-
-		// resets the emitter lifespan, velocity, and rate to fire projectiles
-		projectiles->setVelocity(glm::vec3(0, FIRING_SPEED, 1));
-		projectiles->setRate(FIRERATE);
-		projectiles->setLifespan(LIFE);
-
-		// emit sound
-		//cout << soundLoaded << endl;
-		if (projectiles->started && soundLoaded) {
-			projectiles->playFireSound = true;
-		}
-
+		// space starts the game and fires, once everything is loaded
+		if (assetsReady) sim.post([](Game &game) { game.pressFire(); });
 		break;
 	// keys below to move the player turret
 	case OF_KEY_UP:
@@ -838,8 +329,7 @@ void ofApp::keyPressed(int key){
 			//&& predictionUp.x > 0 && predictionUp.x < ofGetWindowWidth())
 			//projectiles->trans -= (glm::vec3)(projectiles->emitterRot * glm::vec4(0, MOVEMENT_SPEED, 0, 0));
 
-		if (projectiles->started)
-			projectiles->moveForces = (glm::vec3)(projectiles->emitterRot * glm::vec4(0, -(float)shipThrust, 0, 0));
+		sim.post([](Game &game) { game.thrust(0, -1); });
 		break;
 	case OF_KEY_DOWN:
 		// only move down if game started and within bounds
@@ -848,8 +338,7 @@ void ofApp::keyPressed(int key){
 			//&& predictionDown.x > 0 && predictionDown.x < ofGetWindowWidth())
 			//projectiles->trans += (glm::vec3)(projectiles->emitterRot * glm::vec4(0, MOVEMENT_SPEED, 0, 0));
 		
-		if (projectiles->started)
-			projectiles->moveForces = (glm::vec3)(projectiles->emitterRot * glm::vec4(0, (float)shipThrust, 0, 0));
+		sim.post([](Game &game) { game.thrust(0, 1); });
 		break; 
 	case OF_KEY_LEFT:
 		// only move left if game started and within bounds
@@ -858,8 +347,7 @@ void ofApp::keyPressed(int key){
 			//&& predictionLeft.x > 0 && predictionLeft.x < ofGetWindowWidth())
 			//projectiles->trans -= (glm::vec3)(projectiles->emitterRot * glm::vec4(MOVEMENT_SPEED, 0, 0, 0));
 
-		if (projectiles->started)
-			projectiles->moveForces = (glm::vec3)(projectiles->emitterRot * glm::vec4(-(float)shipThrust, 0, 0, 0));
+		sim.post([](Game &game) { game.thrust(-1, 0); });
 		break;
 	case OF_KEY_RIGHT:
 		// only move right if game started and within bounds
@@ -868,38 +356,19 @@ void ofApp::keyPressed(int key){
 			//&& predictionRight.x > 0 && predictionRight.x < ofGetWindowWidth())
 			//projectiles->trans += (glm::vec3)(projectiles->emitterRot * glm::vec4(MOVEMENT_SPEED, 0, 0, 0));
 
-		if (projectiles->started)
-			projectiles->moveForces = (glm::vec3)(projectiles->emitterRot * glm::vec4((float)shipThrust, 0, 0, 0));
+		sim.post([](Game &game) { game.thrust(1, 0); });
 		break;
 	case 'R':
 	case 'r':
 		// only rotate clockwise if game started
-		if (projectiles->started) {
-			//projectiles->rot += ROT_SPEED;
-			projectiles->moveRotForces = (float)shipThrust;
-			/*
-			// adjust rotational matrix accordingly to guide turret travel heading
-			projectiles->setEmitterMat(projectiles->rot);
-			// adjust firing direction
-			projectiles->setFiringDir(projectiles->rot);
-			projectiles->setFiringMat(projectiles->rot);
-			*/
-		}
+		//projectiles->rot += ROT_SPEED;
+		sim.post([](Game &game) { game.spin(1); });
 		break;
 	case 'E':
 	case 'e':
 		// only rotate counterclockwise if game started
-		if (projectiles->started) {
-			//projectiles->rot -= ROT_SPEED;
-			projectiles->moveRotForces = -(float)shipThrust;
-			/*
-			// adjust rotational matrix accordingly to guide turret travel heading
-			projectiles->setEmitterMat(projectiles->rot);
-			// adjust firing direction
-			projectiles->setFiringDir(projectiles->rot);
-			projectiles->setFiringMat(projectiles->rot);
-			*/
-		}
+		//projectiles->rot -= ROT_SPEED;
+		sim.post([](Game &game) { game.spin(-1); });
 		break;
 	default:
 		break;
@@ -909,25 +378,9 @@ void ofApp::keyPressed(int key){
 //--------------------------------------------------------------
 void ofApp::keyReleased(int key){
 	switch (key) {
-	/*
-	Overall idea is to hide emitted projectiles under the ship
-	with no velocity and basically no lifespan
-	to give illusion of stopped firing
-	*/
 	case ' ':
 		//cout << "space released" << endl;
-
-		// when space bar released
-		// projectiles to have no velocity and extreme low rate
-		projectiles->setVelocity(glm::vec3(0, 0, 0));
-		projectiles->setRate(0.001);
-		// lifespan needed to be reduced to avoid trailing 
-		// projectiles as my implementation
-		// does not stop drawing the projectiles
-		projectiles->setLifespan(0);
-
-		// stop sound
-		projectiles->playFireSound = false;
+		sim.post([](Game &game) { game.releaseFire(); });
 		break;
 	default:
 		break;
@@ -943,8 +396,8 @@ void ofApp::mouseMoved(int x, int y ){
 void ofApp::mouseDragged(int x, int y, int button){
 	// only allow mouse to drag turret if game started
 	// and mouse click is in bounds
-	if (!projectiles->started) return;
-	if (!projectiles->bSelected) return;
+	if (!snapshot || !snapshot->gameStarted) return;
+	if (!shipSelected) return;
 
 	glm::vec3 mouse = glm::vec3(x, y, 1);
 	glm::vec3 delta = mouse - mouse_last; // distance to move turret
@@ -952,11 +405,11 @@ void ofApp::mouseDragged(int x, int y, int button){
 	// keep the ship in bounds
 	if (mouse.x < 0 || mouse.x > ofGetWindowWidth() ||
 		mouse.y < 0 || mouse.y > ofGetWindowHeight()) {
-		projectiles->bSelected = false;
+		shipSelected = false;
 		return;
 	}
 		
-	projectiles->trans += delta; // moving the turret
+	sim.post([delta](Game &game) { game.projectiles->trans += delta; }); // moving the turret
 
 	mouse_last = mouse;
 }
@@ -966,8 +419,9 @@ void ofApp::mousePressed(int x, int y, int button){
 	glm::vec3 mouse = glm::vec3(x, y, 1);
 
 	// check if mouse click is within the bounding circle of the turret
-	if (glm::distance(projectiles->trans, mouse) < projectiles->width / 2.0) {
-		projectiles->bSelected = true; // signal that turret can be moved
+	if (!snapshot) return;
+	if (glm::distance(snapshot->ship.trans, mouse) < snapshot->ship.width / 2.0) {
+		shipSelected = true; // signal that turret can be moved
 		mouse_last = mouse; // set mouse click location
 	}
 }
@@ -975,7 +429,7 @@ void ofApp::mousePressed(int x, int y, int button){
 //--------------------------------------------------------------
 void ofApp::mouseReleased(int x, int y, int button){
 	// when mouse click released, it can no longer move turret
-	projectiles->bSelected = false; 
+	shipSelected = false;
 }
 
 //--------------------------------------------------------------
@@ -990,7 +444,7 @@ void ofApp::mouseExited(int x, int y){
 
 //--------------------------------------------------------------
 void ofApp::windowResized(int w, int h){
-
+	sim.post([w, h](Game &game) { game.setWorldSize(w, h); });
 }
 
 //--------------------------------------------------------------
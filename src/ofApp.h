@@ -9,142 +9,17 @@
 
 #include "ofMain.h"
 #include "ofxGui.h"
-
-typedef enum { MoveStop, MoveLeft, MoveRight, MoveUp, MoveDown } MoveDir;
-
-// This is a base object that all drawable object inherit from
-// It is possible this will be replaced by ofNode when we move to 3D
-//
-class BaseObject {
-public:
-	BaseObject();
-	glm::vec3 trans, scale;
-	float	rot;
-	bool	bSelected;
-	void setPosition(glm::vec3);
-
-	// matrix to help with movement of object
-	glm::mat4 getMatrix() {
-		glm::mat4 translation = glm::translate(glm::mat4(1.0), glm::vec3(trans));
-		glm::mat4 rotation = glm::rotate(glm::mat4(1.0), glm::radians(rot), glm::vec3(0, 0, 1));
-		glm::mat4 scaling = glm::scale(glm::mat4(1.0), this->scale);
-
-		return (translation * rotation * scaling);
-	}
-};
-
-//  General Sprite class  (similar to a Particle)
-//
-class Sprite : public BaseObject {
-public:
-	Sprite();
-	void draw();
-	float age();
-	void setImage(ofImage);
-	float speed;    //   in pixels/sec
-	glm::vec3 velocity; // in pixels/sec
-	ofImage image;
-	float birthtime; // elapsed time in ms
-	float lifespan;  //  time in ms
-	string name;
-	bool haveImage;
-	float width, height;
-};
-
-//  Manages all Sprites in a system.  You can create multiple systems
-//
-class SpriteSystem {
-public:
-	void add(Sprite);
-	void remove(int);
-	void update();
-	void setBoom(ofSoundPlayer);
-	int removeNear(glm::vec3 point, float dist);
-	void draw();
-	vector<Sprite> sprites;
-	ofSoundPlayer boomSound;
-	bool hasBoom = false;
-};
-
-
-//  General purpose Emitter class for emitting sprites
-//  This works similar to a Particle emitter
-//
-class Emitter : public BaseObject {
-public:
-	Emitter(SpriteSystem *);
-	void draw();
-	void start();
-	void stop();
-	void setLifespan(float);
-	void setVelocity(glm::vec3);
-	void setChildImage(ofImage);
-	void setChildSize(float w, float h) { childWidth = w; childHeight = h; }
-	void setImage(ofImage);
-	void setRate(float);
-	void setFiringDir(float);
-	void setFiringMat(float);
-	void setEmitterMat(float);
-	void setFireSound(ofSoundPlayer);
-	void update();
-	void integrate();
-
-	glm::vec3 moveVelocity;
-	glm::vec3 moveAcceleration;
-	glm::vec3 moveForces;
-	float moveRotVel;
-	float moveRotAcc;
-	float moveRotForces;
-	float moveDamping;
-
-	SpriteSystem *sys;
-	float rate;
-	float firingDir;
-	glm::mat4 rotDir;
-	glm::vec3 velocity;
-	float lifespan;
-	bool started;
-	float lastSpawned;
-	ofImage childImage;
-	ofImage image;
-	bool drawable;
-	bool haveChildImage;
-	bool haveImage;
-	float width, height;
-	float childWidth, childHeight;
-	glm::mat4 emitterRot;
-	ofSoundPlayer fireSound;
-	bool playFireSound;
-	bool hasSound;
-};
-
-// Particle class for explosion particles
-class Particle : public BaseObject {
-public:
-	Particle(glm::vec3 dot);
-	void draw();
-	void integrate();
-
-	glm::vec3 debrisVel;
-	glm::vec3 debrisAccel;
-	glm::vec3 debrisForces;
-	float debrisDamping;
-};
-
-// actual class for explosion
-class Explosion : public BaseObject {
-public:
-	Explosion(glm::vec3 boomSite, int pts, float life, float power, int dust);
-	void draw();
-	float age();
-	void update();
-
-	float lifespan;
-	float birthtime;
-	int debrisCount;
-	int points;
-	vector<Particle> particles;
-};
+#include "ImageRegistry.h"
+#include "SpriteBatch.h"
+#include "TextCache.h"
+#include "AssetLoader.h"
+#include "AudioSystem.h"
+#include "DebrisRenderer.h"
+#include "EmitterLoader.h"
+#include "StressScenario.h"
+#include "core/Game.h"
+#include "core/SimThread.h"
+#include "core/Profiler.h"
 
 class ofApp : public ofBaseApp{
 
@@ -152,7 +27,8 @@ class ofApp : public ofBaseApp{
 		void setup();
 		void update();
 		void draw();
-		void checkCollisions();
+		void drawProfiler();
+		void finishLoading();
 
 		void keyPressed(int key);
 		void keyReleased(int key);
@@ -166,25 +42,16 @@ class ofApp : public ofBaseApp{
 		void dragEvent(ofDragInfo dragInfo);
 		void gotMessage(ofMessage msg);
 
-		// Explosion stuff
-		void addBoom(glm::vec3 boomPos, int thePts);
-		void removeBoom();
-		vector<Explosion> booms;
-
-		//--------------------
-		Emitter* projectiles;
-		int score;
-
-		// invaders set up
-		Emitter* invaders1;
-		Emitter* invaders2;
-		Emitter* invaders3;
-		Emitter* invaders4;
-		Emitter* invaderS;
-		ofImage invaderImage;
-		bool invaderLoaded;
-		ofImage specInvImage;
-		bool specInvLoaded;
+		// the simulation itself, this app only feeds it input and
+		// draws and plays what it produces. Once the assets are in it
+		// runs on its own thread: input is posted to that thread and
+		// each frame draws the newest snapshot it published.
+		Game game;
+		SimThread sim{ game };
+		const GameSnapshot *snapshot = nullptr;
+		bool shipSelected = false;
+		// set from the command line before setup, see StressScenario
+		StressScenario scenario;
 
 		// needed variables to help with prediction of where
 		// turret will travel in order to keep it in bounds
@@ -193,28 +60,36 @@ class ofApp : public ofBaseApp{
 		//glm::vec3 predictionLeft;
 		//glm::vec3 predictionRight;
 
-		ofImage defaultImage;
-		ofImage turretImage;
+		// every image is loaded once here, sprites only keep a handle;
+		// the images are decoded in the background while the start
+		// screen is up and the game can start once all are in
+		ImageRegistry images;
+		AssetLoader loader;
+		vector<ImageHandle> waveImages; // one per invader wave
+		bool assetsReady = false;
+		bool firstFrameDrawn = false;
+		// all sprites and the ship are drawn through one atlas in one call
+		SpriteBatch spriteBatch;
+		// all explosion debris is drawn in one call as well
+		DebrisRenderer debris;
+		ImageHandle defaultImage;
+		ImageHandle turretImage;
 		glm::vec3 mouse_last;
-		bool imageLoaded;
 
-		ofSoundPlayer firingSound;
-		bool soundLoaded = false;
-		ofSoundPlayer invaderBoom;
-		bool invBoomLoaded = false;
+		// sounds are played once a frame, merged per sound
+		AudioSystem audio;
+		SoundId firingSound = NO_SOUND; // set once the assets are in
+		SoundId invaderBoom = NO_SOUND;
 
-		ofImage bkgImg;
+		ImageHandle bkgImg;
 		bool validBkg = false;
 
 		bool bHide;
 
 		//ofxFloatSlider rate;
 		//ofxFloatSlider fDir;
-		ofxFloatSlider lifespan1;
-		ofxFloatSlider lifespan2;
-		ofxFloatSlider lifespan3;
-		ofxFloatSlider lifespan4;
-		ofxFloatSlider lifespanS;
+		// lifespan of the first few invader waves, one slider each
+		deque<ofxFloatSlider> lifespans;
 		//ofxFloatSlider rate1;
 		//ofxFloatSlider rate2;
 		//ofxFloatSlider rate3;
@@ -228,10 +103,19 @@ class ofApp : public ofBaseApp{
 
 		ofxPanel gui;
 
-		// scoring text
+		// frame timing overlay shown next to the gui
+		bool showProfiler = false;
+		vector<string> waveNames; // of the invader waves it counts
+
+		// scoring text, only laid out again when the score changes
 		ofTrueTypeFont scoreBoard;
+		CachedText scoreText;
 
-		// game start check and text
-		bool gameStarted = false;
+		// game start text
 		ofTrueTypeFont gameStartText;
+		CachedText startText;
+
+		// "+N" points over every explosion
+		ofTrueTypeFont labelFont;
+		LabelBatch boomLabels;
 };